@@ -0,0 +1,919 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "bank.hpp"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include <pkx/PK8.hpp>
+#include <pkx/PKXView.hpp>
+#include <utils/crypto.hpp>
+#include <utils/endian.hpp>
+
+namespace
+{
+    constexpr char MAGIC[8]          = {'E', 'E', 'V', 'E', 'E', 'B', 'N', 'K'};
+    constexpr u32 VERSION            = 1;
+    constexpr size_t HEADER_SIZE     = 0x28;
+    constexpr size_t BOX_ENTRY_SIZE  = 6 * Bank::BOX_SLOTS;
+    constexpr size_t PAGE_ENTRY_SIZE = 10 + 8 * Bank::PAGE_RECORDS;
+    constexpr size_t EXTENT_ALIGN    = 512;
+    constexpr size_t BOX_SIZE        = Bank::SLOT_SIZE * Bank::BOX_SLOTS;
+    // u32 box, u16 slot, u16 checksum over the record with this field zeroed, then the payload
+    constexpr size_t RECORD_SIZE = 8 + Bank::SLOT_SIZE;
+    // Wake the compactor once the journal holds this many edits
+    constexpr size_t COMPACT_RECORDS = 64;
+
+    u16 slotSpecies(const u8* slot)
+    {
+        // The view may decrypt in place, so give it a copy
+        u8 copy[Bank::SLOT_SIZE];
+        memcpy(copy, slot, Bank::SLOT_SIZE);
+        return u16(pksm::PKXView<pksm::PK8>(copy, true)->species());
+    }
+
+    u32 alignExtent(size_t length)
+    {
+        return (length + EXTENT_ALIGN - 1) / EXTENT_ALIGN * EXTENT_ALIGN;
+    }
+
+    // A control byte below 0x80 is followed by that many plus one literal bytes; from 0x80 up it
+    // stands for that many minus 0x7F zero bytes. Returns 0 if the page doesn't get any smaller
+    size_t packPage(const u8* in, u8* out)
+    {
+        size_t read = 0, written = 0;
+        while (read < Bank::PAGE_SIZE)
+        {
+            size_t run = 0;
+            while (read + run < Bank::PAGE_SIZE && in[read + run] == 0 && run < 0x80)
+                run++;
+            if (run >= 2)
+            {
+                if (written + 1 >= Bank::PAGE_SIZE)
+                    return 0;
+                out[written++] = u8(0x7F + run);
+                read += run;
+                continue;
+            }
+
+            // Literals end at the next pair of zeroes
+            size_t literals = 0;
+            while (read + literals < Bank::PAGE_SIZE && literals < 0x80 &&
+                   !(in[read + literals] == 0 && read + literals + 1 < Bank::PAGE_SIZE &&
+                       in[read + literals + 1] == 0))
+                literals++;
+            if (written + 1 + literals >= Bank::PAGE_SIZE)
+                return 0;
+            out[written++] = u8(literals - 1);
+            memcpy(out + written, in + read, literals);
+            written += literals;
+            read += literals;
+        }
+        return written;
+    }
+
+    bool unpackPage(const u8* in, size_t length, u8* out)
+    {
+        size_t read = 0, written = 0;
+        while (read < length)
+        {
+            u8 control = in[read++];
+            if (control >= 0x80)
+            {
+                size_t run = control - 0x7F;
+                if (written + run > Bank::PAGE_SIZE)
+                    return false;
+                memset(out + written, 0, run);
+                written += run;
+            }
+            else
+            {
+                size_t literals = control + 1;
+                if (read + literals > length || written + literals > Bank::PAGE_SIZE)
+                    return false;
+                memcpy(out + written, in + read, literals);
+                read += literals;
+                written += literals;
+            }
+        }
+        return written == Bank::PAGE_SIZE;
+    }
+
+    // FNV-1a
+    u64 recordHash(const u8* record)
+    {
+        u64 hash = 0xCBF29CE484222325;
+        for (size_t i = 0; i < Bank::SLOT_SIZE; i++)
+            hash = (hash ^ record[i]) * 0x100000001B3;
+        return hash;
+    }
+
+    bool writeAt(FILE* file, u32 offset, const u8* data, size_t length)
+    {
+        return fseek(file, offset, SEEK_SET) == 0 && fwrite(data, 1, length, file) == length;
+    }
+
+    bool flushToDisk(FILE* file)
+    {
+        return fflush(file) == 0 && fsync(fileno(file)) == 0;
+    }
+}
+
+Bank::Bank(const std::string& path, size_t residentBudget, bool packPages)
+    : path(path),
+      residentBudget(residentBudget),
+      packPages(packPages),
+      journalPath(path + ".journal")
+{
+    std::unique_ptr<pksm::Storage> storage = pksm::Storage::open(path);
+    if (!storage)
+    {
+        this->create();
+    }
+    else
+    {
+        pksm::Span<const u8> start = storage->read(0, sizeof(MAGIC) + 4);
+        std::string backupPath;
+        if (storage->size() < HEADER_SIZE || start.size() != sizeof(MAGIC) + 4 ||
+            memcmp(start.data(), MAGIC, sizeof(MAGIC)) != 0)
+        {
+            this->convert(storage->read(0, storage->size()));
+            backupPath = path + ".v0.bak";
+        }
+        else
+        {
+            this->readHeader(*storage);
+        }
+
+        // Pages are read from the bank file as it's written, so they don't go through storage
+        storage.reset();
+        if (!backupPath.empty())
+            this->replaceOriginal(backupPath);
+        else if (!(this->file = fopen(path.c_str(), "r+b")))
+            throw std::runtime_error("Could not open " + path);
+    }
+
+    this->replayJournal();
+    this->compactor = std::thread(&Bank::compactLoop, this);
+}
+
+Bank::~Bank()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->compactWake.notify_one();
+    if (this->compactor.joinable())
+        this->compactor.join();
+
+    if (this->journalRecords > 0 || this->anyDirty())
+        this->compact();
+    if (this->journal)
+        fclose(this->journal);
+    if (this->file)
+        fclose(this->file);
+}
+
+size_t Bank::boxes()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->boxIndex.size();
+}
+
+pksm::Species Bank::species(size_t box, size_t slot)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return pksm::Species{this->boxIndex[box].species[slot]};
+}
+
+void Bank::readSlot(size_t box, size_t slot, u8* out)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    u32 record = this->boxIndex[box].records[slot];
+    if (record == NO_RECORD)
+        memset(out, 0, SLOT_SIZE);
+    else
+        memcpy(out,
+            this->page(record / PAGE_RECORDS).data.get() + (record % PAGE_RECORDS) * SLOT_SIZE,
+            SLOT_SIZE);
+}
+
+void Bank::writeSlot(size_t box, size_t slot, const u8* data)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->applySlot(box, slot, data);
+    this->appendJournal(box, slot, data);
+}
+
+bool Bank::boxIntact(size_t box)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (u32 record : this->boxIndex[box].records)
+    {
+        if (record != NO_RECORD && !this->page(record / PAGE_RECORDS).intact)
+            return false;
+    }
+    return true;
+}
+
+double Bank::dedupRatio()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    size_t slots = 0, records = 0;
+    for (u32 count : this->refCounts)
+    {
+        slots += count;
+        records += count > 0;
+    }
+    return records == 0 ? 1.0 : double(slots) / records;
+}
+
+void Bank::addBox()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    u8 empty[SLOT_SIZE] = {};
+    size_t box          = this->boxIndex.size();
+    this->applySlot(box, 0, empty);
+    this->appendJournal(box, 0, empty);
+}
+
+bool Bank::dirty()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->journalRecords > 0 || this->anyDirty();
+}
+
+bool Bank::save()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->journalRecords > 0 || this->anyDirty())
+    {
+        this->compactRequested = true;
+        this->compactWake.notify_one();
+    }
+    return !this->writeFailed;
+}
+
+bool Bank::compact()
+{
+    std::lock_guard<std::mutex> compactLock(this->compactMutex);
+
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        snapshot.boxIndex       = this->boxIndex;
+        snapshot.pageIndex      = this->pageIndex;
+        snapshot.indexDirty     = this->indexDirty;
+        snapshot.journalRecords = this->journalRecords;
+        snapshot.releasedRecords.swap(this->releasedRecords);
+        for (size_t page = 0; page < this->pages.size(); page++)
+        {
+            Page& resident = this->pages[page];
+            if (!resident.dirty)
+                continue;
+            std::unique_ptr<u8[]> data(new u8[PAGE_SIZE]);
+            memcpy(data.get(), resident.data.get(), PAGE_SIZE);
+            snapshot.pages.emplace_back(page, std::move(data));
+            // Kept resident until it's written, since the file doesn't have it yet
+            resident.dirty      = false;
+            resident.writing    = true;
+            snapshot.indexDirty = true;
+        }
+        this->indexDirty = false;
+    }
+
+    // The bank file is on disk before the journal goes, so a crash in between only replays edits
+    // that are already there
+    bool written = this->writePages(snapshot);
+    if (written)
+    {
+        for (const auto& extent : snapshot.releasedExtents)
+            this->freeExtent(extent.first, extent.second);
+        this->trimFile();
+        if (snapshot.indexCapacity > 0)
+        {
+            this->indexCapacity = snapshot.indexCapacity;
+            this->indexOffset   = snapshot.indexOffset;
+            this->indexChecksum = snapshot.indexChecksum;
+        }
+    }
+    else if (!snapshot.headerWritten)
+    {
+        // The header on disk still points at the old extents, so only the new ones are free. Past
+        // that it may point at either, and neither is reused until the bank is opened again
+        for (const auto& extent : snapshot.allocatedExtents)
+            this->freeExtent(extent.first, extent.second);
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (const auto& stored : snapshot.pages)
+    {
+        Page& resident   = this->pages[stored.first];
+        resident.writing = false;
+        if (!written)
+        {
+            resident.dirty = true;
+            continue;
+        }
+        const PageEntry& onDisk = snapshot.pageIndex[stored.first];
+        PageEntry& entry        = this->pageIndex[stored.first];
+        entry.offset            = onDisk.offset;
+        entry.length            = onDisk.length;
+        entry.checksum          = onDisk.checksum;
+        entry.flags             = onDisk.flags;
+        resident.intact         = true;
+    }
+    if (!written)
+    {
+        this->indexDirty = this->indexDirty || snapshot.indexDirty;
+        this->releasedRecords.insert(this->releasedRecords.end(), snapshot.releasedRecords.begin(),
+            snapshot.releasedRecords.end());
+        this->writeFailed = true;
+        return false;
+    }
+
+    // Nothing on disk points at the released records any more
+    this->freeRecords.insert(this->freeRecords.end(), snapshot.releasedRecords.begin(),
+        snapshot.releasedRecords.end());
+    // Edits journaled since the snapshot aren't in the file yet, so then the journal stays whole;
+    // replaying what's already in the file again does no harm
+    if (snapshot.journalRecords > 0 && this->journalRecords == snapshot.journalRecords)
+    {
+        if (fflush(this->journal) != 0 || ftruncate(fileno(this->journal), 0) != 0 ||
+            fseek(this->journal, 0, SEEK_SET) != 0)
+        {
+            this->writeFailed = true;
+            return false;
+        }
+        this->journalRecords = 0;
+    }
+    this->writeFailed = false;
+    return true;
+}
+
+void Bank::create()
+{
+    this->file = fopen(this->path.c_str(), "w+b");
+    if (!this->file)
+        throw std::runtime_error("Could not create " + this->path);
+
+    // The header takes a whole extent too, so every extent after it starts aligned
+    this->fileEnd = alignExtent(HEADER_SIZE);
+    this->appendBox();
+    if (!this->compact())
+        throw std::runtime_error("Could not write " + this->path);
+}
+
+// Builds the converted bank next to the original, for replaceOriginal to swap in
+void Bank::convert(pksm::Span<const u8> slots)
+{
+    std::string finalPath = this->path;
+    this->path += ".tmp";
+    this->create();
+    // A short last box is kept too; its missing slots stay empty
+    size_t oldBoxes = std::max<size_t>(1, (slots.size() + BOX_SIZE - 1) / BOX_SIZE);
+    for (size_t box = 0; box < oldBoxes; box++)
+    {
+        for (size_t slot = 0; slot < BOX_SLOTS; slot++)
+        {
+            size_t offset = (box * BOX_SLOTS + slot) * SLOT_SIZE;
+            if (offset + SLOT_SIZE <= slots.size())
+                this->applySlot(box, slot, slots.data() + offset);
+        }
+        // There's no compactor yet to write out the dirty pages that keep the budget from holding
+        if (this->lru.size() * PAGE_SIZE > this->residentBudget)
+            this->compact();
+    }
+    bool saved = this->compact();
+    fclose(this->file);
+    this->file = nullptr;
+    this->path = finalPath;
+    if (!saved)
+        throw std::runtime_error("Could not convert " + finalPath);
+}
+
+void Bank::replaceOriginal(const std::string& backupPath)
+{
+    std::string finalPath = this->path;
+    std::string tempPath  = this->path + ".tmp";
+    remove(backupPath.c_str());
+    if (rename(finalPath.c_str(), backupPath.c_str()) != 0 ||
+        rename(tempPath.c_str(), finalPath.c_str()) != 0)
+        throw std::runtime_error("Could not replace " + finalPath);
+
+    this->file = fopen(this->path.c_str(), "r+b");
+    if (!this->file)
+        throw std::runtime_error("Could not open " + this->path);
+}
+
+void Bank::readHeader(pksm::Storage& storage)
+{
+    u8 header[HEADER_SIZE];
+    pksm::Span<const u8> read = storage.read(0, HEADER_SIZE);
+    std::copy(read.begin(), read.end(), header);
+    if (read.size() != HEADER_SIZE ||
+        LittleEndian::convertTo<u16>(header + 0x26) != pksm::crypto::ccitt16(header, 0x26))
+        throw std::runtime_error(this->path + " has a corrupt header");
+    if (LittleEndian::convertTo<u32>(header + 0x08) > VERSION)
+        throw std::runtime_error(this->path + " is from a newer version of Eevee");
+    if (LittleEndian::convertTo<u32>(header + 0x0C) != PAGE_SIZE)
+        throw std::runtime_error(this->path + " has an unsupported page size");
+
+    u32 boxCount        = LittleEndian::convertTo<u32>(header + 0x10);
+    u32 pageCount       = LittleEndian::convertTo<u32>(header + 0x14);
+    this->indexCapacity = LittleEndian::convertTo<u32>(header + 0x18);
+    this->indexOffset   = LittleEndian::convertTo<u32>(header + 0x1C);
+    this->indexChecksum = LittleEndian::convertTo<u16>(header + 0x20);
+    size_t indexSize = size_t(boxCount) * BOX_ENTRY_SIZE + size_t(pageCount) * PAGE_ENTRY_SIZE;
+    if (boxCount == 0 || indexSize > this->indexCapacity)
+        throw std::runtime_error(this->path + " has a corrupt header");
+
+    pksm::Span<const u8> entries = storage.read(this->indexOffset, indexSize);
+    if (entries.size() != indexSize ||
+        this->indexChecksum != pksm::crypto::ccitt16(entries.data(), entries.size()))
+        throw std::runtime_error(this->path + " has a corrupt box index");
+
+    this->boxIndex.resize(boxCount);
+    this->pageIndex.resize(pageCount);
+    this->pages.resize(pageCount);
+    this->refCounts.assign(pageCount * PAGE_RECORDS, 0);
+    for (size_t box = 0; box < boxCount; box++)
+    {
+        const u8* raw   = entries.data() + box * BOX_ENTRY_SIZE;
+        BoxEntry& entry = this->boxIndex[box];
+        for (size_t slot = 0; slot < BOX_SLOTS; slot++)
+        {
+            entry.records[slot] = LittleEndian::convertTo<u32>(raw + slot * 4);
+            entry.species[slot] = LittleEndian::convertTo<u16>(raw + BOX_SLOTS * 4 + slot * 2);
+            if (entry.records[slot] == NO_RECORD)
+                continue;
+            if (entry.records[slot] >= this->refCounts.size())
+                throw std::runtime_error(this->path + " has a corrupt box index");
+            this->refCounts[entry.records[slot]]++;
+        }
+    }
+    for (size_t page = 0; page < pageCount; page++)
+    {
+        const u8* raw    = entries.data() + boxCount * BOX_ENTRY_SIZE + page * PAGE_ENTRY_SIZE;
+        PageEntry& entry = this->pageIndex[page];
+        entry.offset     = LittleEndian::convertTo<u32>(raw);
+        entry.length     = LittleEndian::convertTo<u16>(raw + 4);
+        entry.checksum   = LittleEndian::convertTo<u16>(raw + 6);
+        entry.flags      = LittleEndian::convertTo<u16>(raw + 8);
+        for (size_t record = 0; record < PAGE_RECORDS; record++)
+            entry.hashes[record] = LittleEndian::convertTo<u64>(raw + 10 + record * 8);
+        if (entry.length > PAGE_SIZE)
+            throw std::runtime_error(this->path + " has a corrupt box index");
+    }
+    this->findFreeExtents();
+
+    // Walked backwards so the lowest numbers are handed out first and win hash ties
+    for (size_t record = this->refCounts.size(); record-- > 0;)
+    {
+        if (this->refCounts[record] == 0)
+            this->freeRecords.push_back(record);
+        else
+        {
+            u64 hash = this->pageIndex[record / PAGE_RECORDS].hashes[record % PAGE_RECORDS];
+            this->recordsByHash[hash] = record;
+        }
+    }
+}
+
+// Everything the header and index don't account for is free
+void Bank::findFreeExtents()
+{
+    std::vector<std::pair<u32, u32>> used{
+        {0, alignExtent(HEADER_SIZE)}, {this->indexOffset, this->indexCapacity}};
+    for (const PageEntry& entry : this->pageIndex)
+    {
+        if (entry.length > 0)
+            used.emplace_back(entry.offset, alignExtent(entry.length));
+    }
+    std::sort(used.begin(), used.end());
+
+    this->fileEnd = 0;
+    for (const auto& extent : used)
+    {
+        if (extent.first > this->fileEnd)
+            this->freeExtents.emplace(this->fileEnd, extent.first - this->fileEnd);
+        this->fileEnd = std::max(this->fileEnd, extent.first + extent.second);
+    }
+}
+
+void Bank::replayJournal()
+{
+    this->journal = fopen(this->journalPath.c_str(), "r+b");
+    if (!this->journal)
+    {
+        this->journal = fopen(this->journalPath.c_str(), "w+b");
+        if (!this->journal)
+            throw std::runtime_error("Could not create " + this->journalPath);
+        return;
+    }
+
+    u8 record[RECORD_SIZE];
+    while (fread(record, 1, RECORD_SIZE, this->journal) == RECORD_SIZE)
+    {
+        u32 box    = LittleEndian::convertTo<u32>(record);
+        u16 slot   = LittleEndian::convertTo<u16>(record + 4);
+        u16 stored = LittleEndian::convertTo<u16>(record + 6);
+        LittleEndian::convertFrom<u16>(record + 6, 0);
+        // A torn or garbled record ends the replay; it was never acknowledged. Boxes are added one
+        // at a time, so a record can be at most one past the last box
+        if (slot >= BOX_SLOTS || box > this->boxIndex.size() ||
+            stored != pksm::crypto::ccitt16(record, RECORD_SIZE))
+            break;
+        this->applySlot(box, slot, record + 8);
+        this->journalRecords++;
+    }
+
+    // Drop anything after the last good record so new edits aren't appended behind garbage
+    fflush(this->journal);
+    if (ftruncate(fileno(this->journal), this->journalRecords * RECORD_SIZE) != 0 ||
+        fseek(this->journal, this->journalRecords * RECORD_SIZE, SEEK_SET) != 0)
+        throw std::runtime_error("Could not open " + this->journalPath);
+    this->compactRequested = this->journalRecords > 0;
+}
+
+void Bank::compactLoop()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+        this->compactWake.wait(lock, [this] { return this->compactRequested || this->stopping; });
+        if (this->stopping)
+            return;
+        this->compactRequested = false;
+        lock.unlock();
+        this->compact();
+        lock.lock();
+    }
+}
+
+Bank::Page& Bank::page(size_t page)
+{
+    Page& resident = this->pages[page];
+    if (!resident.data)
+    {
+        const PageEntry& entry = this->pageIndex[page];
+        resident.data          = std::unique_ptr<u8[]>(new u8[PAGE_SIZE]());
+        resident.intact        = true;
+        if (entry.length > 0)
+        {
+            std::unique_ptr<u8[]> stored;
+            u8* read = resident.data.get();
+            if (entry.flags & PAGE_PACKED)
+            {
+                stored = std::unique_ptr<u8[]>(new u8[entry.length]);
+                read   = stored.get();
+            }
+            {
+                std::lock_guard<std::mutex> lock(this->fileMutex);
+                resident.intact = fseek(this->file, entry.offset, SEEK_SET) == 0 &&
+                                  fread(read, 1, entry.length, this->file) == entry.length;
+            }
+            resident.intact =
+                resident.intact && pksm::crypto::ccitt16(read, entry.length) == entry.checksum;
+            if (resident.intact && stored)
+                resident.intact = unpackPage(stored.get(), entry.length, resident.data.get());
+        }
+        this->lru.push_front(page);
+        resident.lruPos = this->lru.begin();
+        this->evict();
+    }
+    else
+    {
+        this->lru.splice(this->lru.begin(), this->lru, resident.lruPos);
+    }
+    return resident;
+}
+
+void Bank::evict()
+{
+    bool dirtyLeft = false;
+    for (auto victim = this->lru.end(); this->lru.size() * PAGE_SIZE > this->residentBudget;)
+    {
+        // The page just touched always stays
+        if (--victim == this->lru.begin())
+            break;
+        Page& page = this->pages[*victim];
+        if (page.dirty || page.writing)
+        {
+            dirtyLeft = true;
+            continue;
+        }
+        page.data.reset();
+        victim = this->lru.erase(victim);
+    }
+
+    if (dirtyLeft)
+    {
+        this->compactRequested = true;
+        this->compactWake.notify_one();
+    }
+}
+
+void Bank::applySlot(size_t box, size_t slot, const u8* data)
+{
+    if (box == this->boxIndex.size())
+        this->appendBox();
+
+    u8 payload[SLOT_SIZE];
+    memcpy(payload, data, SLOT_SIZE);
+    pksm::PK8::decryptSlot(payload, true);
+    u32 record = NO_RECORD;
+    if (std::any_of(payload, payload + SLOT_SIZE, [](u8 byte) { return byte != 0; }))
+    {
+        u64 hash = recordHash(payload);
+        record   = this->findRecord(hash, payload);
+        if (record == NO_RECORD)
+            record = this->storeRecord(hash, payload);
+        // Taken before the old one is dropped, so rewriting a slot with its own payload keeps it
+        this->refCounts[record]++;
+    }
+
+    BoxEntry& entry = this->boxIndex[box];
+    this->releaseRecord(entry.records[slot]);
+    entry.records[slot] = record;
+    entry.species[slot] = record == NO_RECORD ? 0 : slotSpecies(payload);
+    this->indexDirty    = true;
+}
+
+u32 Bank::findRecord(u64 hash, const u8* data)
+{
+    auto found = this->recordsByHash.find(hash);
+    if (found == this->recordsByHash.end())
+        return NO_RECORD;
+    u32 record      = found->second;
+    const u8* bytes =
+        this->page(record / PAGE_RECORDS).data.get() + (record % PAGE_RECORDS) * SLOT_SIZE;
+    return memcmp(bytes, data, SLOT_SIZE) == 0 ? record : NO_RECORD;
+}
+
+u32 Bank::storeRecord(u64 hash, const u8* data)
+{
+    if (this->freeRecords.empty())
+        this->appendPage();
+    u32 record = this->freeRecords.back();
+    this->freeRecords.pop_back();
+
+    Page& page = this->page(record / PAGE_RECORDS);
+    memcpy(page.data.get() + (record % PAGE_RECORDS) * SLOT_SIZE, data, SLOT_SIZE);
+    page.dirty = true;
+    this->pageIndex[record / PAGE_RECORDS].hashes[record % PAGE_RECORDS] = hash;
+    this->recordsByHash.emplace(hash, record);
+    this->indexDirty = true;
+    return record;
+}
+
+void Bank::releaseRecord(u32 record)
+{
+    if (record == NO_RECORD || --this->refCounts[record] > 0)
+        return;
+    u64 hash   = this->pageIndex[record / PAGE_RECORDS].hashes[record % PAGE_RECORDS];
+    auto found = this->recordsByHash.find(hash);
+    if (found != this->recordsByHash.end() && found->second == record)
+        this->recordsByHash.erase(found);
+    // The index on disk may still point here until the next compaction
+    this->releasedRecords.push_back(record);
+}
+
+void Bank::appendBox()
+{
+    BoxEntry entry;
+    entry.records.fill(NO_RECORD);
+    entry.species.fill(0);
+    this->boxIndex.push_back(entry);
+    this->indexDirty = true;
+}
+
+void Bank::appendPage()
+{
+    this->pageIndex.push_back(PageEntry{});
+
+    size_t first = this->refCounts.size();
+    this->refCounts.resize(first + PAGE_RECORDS, 0);
+    for (size_t record = first + PAGE_RECORDS; record-- > first;)
+        this->freeRecords.push_back(record);
+
+    Page page;
+    page.data  = std::unique_ptr<u8[]>(new u8[PAGE_SIZE]());
+    page.dirty = true;
+    this->pages.push_back(std::move(page));
+    this->lru.push_front(this->pages.size() - 1);
+    this->pages.back().lruPos = this->lru.begin();
+
+    this->indexDirty = true;
+    this->evict();
+}
+
+// First fit, or else the end of the file
+u32 Bank::allocateExtent(u32 size)
+{
+    for (auto free = this->freeExtents.begin(); free != this->freeExtents.end(); ++free)
+    {
+        if (free->second < size)
+            continue;
+        u32 offset = free->first;
+        u32 left   = free->second - size;
+        this->freeExtents.erase(free);
+        if (left > 0)
+            this->freeExtents.emplace(offset + size, left);
+        return offset;
+    }
+    u32 offset = this->fileEnd;
+    this->fileEnd += size;
+    return offset;
+}
+
+void Bank::freeExtent(u32 offset, u32 size)
+{
+    auto next = this->freeExtents.lower_bound(offset);
+    if (next != this->freeExtents.end() && offset + size == next->first)
+    {
+        size += next->second;
+        next = this->freeExtents.erase(next);
+    }
+    if (next != this->freeExtents.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset)
+        {
+            previous->second += size;
+            return;
+        }
+    }
+    this->freeExtents.emplace_hint(next, offset, size);
+}
+
+void Bank::appendJournal(size_t box, size_t slot, const u8* data)
+{
+    u8 record[RECORD_SIZE] = {};
+    LittleEndian::convertFrom<u32>(record, box);
+    LittleEndian::convertFrom<u16>(record + 4, slot);
+    memcpy(record + 8, data, SLOT_SIZE);
+    LittleEndian::convertFrom<u16>(record + 6, pksm::crypto::ccitt16(record, RECORD_SIZE));
+    if (fwrite(record, 1, RECORD_SIZE, this->journal) != RECORD_SIZE || !flushToDisk(this->journal))
+        this->writeFailed = true;
+
+    if (++this->journalRecords >= COMPACT_RECORDS)
+    {
+        this->compactRequested = true;
+        this->compactWake.notify_one();
+    }
+}
+
+// Free space at the end of the file goes back to the filesystem
+void Bank::trimFile()
+{
+    if (this->freeExtents.empty())
+        return;
+    auto last = std::prev(this->freeExtents.end());
+    if (last->first + last->second != this->fileEnd)
+        return;
+    this->fileEnd = last->first;
+    this->freeExtents.erase(last);
+
+    std::lock_guard<std::mutex> lock(this->fileMutex);
+    if (fflush(this->file) == 0)
+        ftruncate(fileno(this->file), this->fileEnd);
+}
+
+bool Bank::anyDirty() const
+{
+    return this->indexDirty || std::any_of(this->pages.begin(), this->pages.end(),
+                                   [](const Page& page) { return page.dirty; });
+}
+
+bool Bank::writeFile(u32 offset, const u8* data, size_t length)
+{
+    std::lock_guard<std::mutex> lock(this->fileMutex);
+    return writeAt(this->file, offset, data, length);
+}
+
+// Only the flush needs the lock; readers can carry on while the sync waits
+bool Bank::syncFile()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->fileMutex);
+        if (fflush(this->file) != 0)
+            return false;
+    }
+    return fsync(fileno(this->file)) == 0;
+}
+
+bool Bank::writePages(Snapshot& snapshot)
+{
+    std::unique_ptr<u8[]> packed;
+    for (const auto& written : snapshot.pages)
+    {
+        PageEntry& entry = snapshot.pageIndex[written.first];
+        const u8* stored = written.second.get();
+        size_t length    = PAGE_SIZE;
+        entry.flags &= ~PAGE_PACKED;
+        if (this->packPages)
+        {
+            if (!packed)
+                packed = std::unique_ptr<u8[]>(new u8[PAGE_SIZE]);
+            if (size_t packedLength = packPage(written.second.get(), packed.get()))
+            {
+                stored = packed.get();
+                length = packedLength;
+                entry.flags |= PAGE_PACKED;
+            }
+        }
+        // Never over the copy the header on disk points at; other slots may share its records
+        if (entry.length > 0)
+            snapshot.releasedExtents.emplace_back(entry.offset, alignExtent(entry.length));
+        entry.offset = this->allocateExtent(alignExtent(length));
+        snapshot.allocatedExtents.emplace_back(entry.offset, alignExtent(length));
+        entry.length   = length;
+        entry.checksum = pksm::crypto::ccitt16(stored, length);
+        if (!this->writeFile(entry.offset, stored, length))
+            return false;
+    }
+
+    if (!snapshot.indexDirty)
+        return this->syncFile();
+
+    // The new index goes to a free extent and is on disk before the header switches to it, so a
+    // crash at any point leaves a header and index that match
+    if (!this->writeIndex(snapshot) || !this->syncFile())
+        return false;
+    snapshot.headerWritten = true;
+    return this->writeHeader(snapshot) && this->syncFile();
+}
+
+bool Bank::writeIndex(Snapshot& snapshot)
+{
+    const std::vector<BoxEntry>& boxIndex   = snapshot.boxIndex;
+    const std::vector<PageEntry>& pageIndex = snapshot.pageIndex;
+    std::vector<u8> entries(boxIndex.size() * BOX_ENTRY_SIZE + pageIndex.size() * PAGE_ENTRY_SIZE);
+    for (size_t box = 0; box < boxIndex.size(); box++)
+    {
+        u8* raw               = entries.data() + box * BOX_ENTRY_SIZE;
+        const BoxEntry& entry = boxIndex[box];
+        for (size_t slot = 0; slot < BOX_SLOTS; slot++)
+        {
+            LittleEndian::convertFrom<u32>(raw + slot * 4, entry.records[slot]);
+            LittleEndian::convertFrom<u16>(raw + BOX_SLOTS * 4 + slot * 2, entry.species[slot]);
+        }
+    }
+    for (size_t page = 0; page < pageIndex.size(); page++)
+    {
+        u8* raw = entries.data() + boxIndex.size() * BOX_ENTRY_SIZE + page * PAGE_ENTRY_SIZE;
+        const PageEntry& entry = pageIndex[page];
+        LittleEndian::convertFrom<u32>(raw, entry.offset);
+        LittleEndian::convertFrom<u16>(raw + 4, entry.length);
+        LittleEndian::convertFrom<u16>(raw + 6, entry.checksum);
+        LittleEndian::convertFrom<u16>(raw + 8, entry.flags);
+        for (size_t record = 0; record < PAGE_RECORDS; record++)
+            LittleEndian::convertFrom<u64>(raw + 10 + record * 8, entry.hashes[record]);
+    }
+
+    snapshot.indexCapacity = alignExtent(entries.size());
+    snapshot.indexOffset   = this->allocateExtent(snapshot.indexCapacity);
+    snapshot.indexChecksum = pksm::crypto::ccitt16(entries.data(), entries.size());
+    snapshot.allocatedExtents.emplace_back(snapshot.indexOffset, snapshot.indexCapacity);
+    if (this->indexCapacity > 0)
+        snapshot.releasedExtents.emplace_back(this->indexOffset, this->indexCapacity);
+    return this->writeFile(snapshot.indexOffset, entries.data(), entries.size());
+}
+
+bool Bank::writeHeader(const Snapshot& snapshot)
+{
+    u8 header[HEADER_SIZE] = {};
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    LittleEndian::convertFrom<u32>(header + 0x08, VERSION);
+    LittleEndian::convertFrom<u32>(header + 0x0C, PAGE_SIZE);
+    LittleEndian::convertFrom<u32>(header + 0x10, snapshot.boxIndex.size());
+    LittleEndian::convertFrom<u32>(header + 0x14, snapshot.pageIndex.size());
+    LittleEndian::convertFrom<u32>(header + 0x18, snapshot.indexCapacity);
+    LittleEndian::convertFrom<u32>(header + 0x1C, snapshot.indexOffset);
+    LittleEndian::convertFrom<u16>(header + 0x20, snapshot.indexChecksum);
+    LittleEndian::convertFrom<u16>(header + 0x26, pksm::crypto::ccitt16(header, 0x26));
+    return this->writeFile(0, header, HEADER_SIZE);
+}
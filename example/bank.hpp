@@ -0,0 +1,233 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <array>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <enums/Species.hpp>
+#include <utils/coretypes.h>
+#include <utils/storage.hpp>
+
+// Eevee.bank, version 1:
+//
+//   0x00  header      magic "EEVEEBNK", version, page size, box and page counts, index capacity and
+//                     offset, index checksum, header checksum
+//   ...   index       one BoxEntry per box (the record and species of each slot, so the bank list
+//                     can be shown without reading any page), then one PageEntry per page (its
+//                     offset, stored length, checksum, flags and the hash of each record on it)
+//   ...   pages       30 records each, in any order. A record is a decrypted party-length PK8
+//
+// A page is stored zero-run packed when that makes it smaller, and its checksum covers the bytes as
+// stored. The header, pages and index each take up whole extents of 512 bytes, so every extent
+// starts aligned. Pages and the index are never written over the copy the header points at: each
+// compaction writes them to free extents and syncs them, and only then writes the header that
+// switches to them. The extents they replace become free once the new header is on disk, free space
+// at the end of the file is cut off, and the gaps left elsewhere are found again on open
+//
+// Records are content-addressed: a slot holds a record number, and writing a payload that's already
+// stored anywhere in the bank just references the existing record. Records are never changed in
+// place, so editing one of several clones writes a new record and leaves the others alone. A record
+// nothing points to any more isn't reused until the index that dropped it is on disk. Slots that
+// were never written point at no record and read back as zeroes
+//
+// Opening reads the header and index only, through pksm::Storage; pages are read and unpacked the
+// first time one of their records is touched. Files in the old flat format (raw 344-byte slots) are
+// converted on open and the original is kept as Eevee.bank.v0.bak
+//
+// Every writeSlot and addBox is also appended to Eevee.bank.journal (box, slot, checksum, payload)
+// and flushed before it returns, so an edit survives a crash as soon as it's made; a new box is an
+// empty write to slot 0 one past the last box. The journal is replayed on open. A background thread
+// compacts it into the bank file, writing the dirty pages, then the index, then the header, and
+// only then truncating the journal. It copies the dirty pages and the index under the lock and
+// writes them without it, so slots can still be read and written while the file is synced
+//
+// Only a bounded number of pages stay in memory. Pages are kept in least-recently-used order, and
+// once they exceed the resident budget the oldest clean ones are dropped; dirty ones, and ones
+// being written, stay and wake the compactor instead
+class Bank
+{
+  public:
+    static constexpr size_t SLOT_SIZE = 344;
+    static constexpr size_t BOX_SLOTS = 30;
+    static constexpr size_t PAGE_RECORDS = 30;
+    static constexpr size_t PAGE_SIZE    = SLOT_SIZE * PAGE_RECORDS;
+    // About 200 pages
+    static constexpr size_t DEFAULT_RESIDENT_BUDGET = 2 * 1024 * 1024;
+
+    // Throws std::runtime_error if the file can't be opened, created or converted, or its header
+    // or index fail their checksums. With packPages off, pages are written unpacked; packed ones
+    // already in the file can still be read
+    Bank(const std::string& path, size_t residentBudget = DEFAULT_RESIDENT_BUDGET,
+        bool packPages = true);
+    // Compacts whatever is still in the journal
+    ~Bank();
+
+    Bank(const Bank&) = delete;
+    Bank& operator=(const Bank&) = delete;
+
+    size_t boxes();
+    // Comes from the index, so it never touches the page
+    pksm::Species species(size_t box, size_t slot);
+
+    void readSlot(size_t box, size_t slot, u8* out);
+    // The box has to exist already
+    void writeSlot(size_t box, size_t slot, const u8* data);
+    // False if a page holding one of the box's records didn't match its checksum when it was read
+    bool boxIntact(size_t box);
+    // Occupied slots per stored record; 1 when nothing is shared
+    double dedupRatio();
+
+    // Appends an empty box
+    void addBox();
+    bool dirty();
+    // Edits are already journaled, so this only wakes the compactor. False if a journal append or
+    // the last compaction failed
+    bool save();
+    // Compacts the journal into the bank file right away, after any compaction already running
+    bool compact();
+
+  private:
+    static constexpr u32 NO_RECORD   = 0xFFFFFFFF;
+    static constexpr u16 PAGE_PACKED = 1 << 0;
+
+    struct BoxEntry
+    {
+        std::array<u32, BOX_SLOTS> records;
+        std::array<u16, BOX_SLOTS> species;
+    };
+
+    struct PageEntry
+    {
+        // Both 0 until the page is first written
+        u32 offset;
+        u16 length;
+        u16 checksum;
+        u16 flags;
+        std::array<u64, PAGE_RECORDS> hashes;
+    };
+
+    struct Page
+    {
+        std::unique_ptr<u8[]> data;
+        bool dirty   = false;
+        bool intact  = true;
+        bool writing = false;
+        std::list<size_t>::iterator lruPos;
+    };
+
+    std::string path;
+    FILE* file = nullptr;
+    std::vector<BoxEntry> boxIndex;
+    std::vector<PageEntry> pageIndex;
+    std::vector<Page> pages;
+    bool indexDirty = false;
+
+    // Slots pointing at each record, and the first live record with each hash
+    std::vector<u32> refCounts;
+    std::unordered_map<u64, u32> recordsByHash;
+    // Unreferenced records that can be handed out again, and ones released since the last
+    // compaction
+    std::vector<u32> freeRecords;
+    std::vector<u32> releasedRecords;
+
+    // Resident pages, most recently used first
+    std::list<size_t> lru;
+    size_t residentBudget;
+    bool packPages;
+
+    std::string journalPath;
+    FILE* journal         = nullptr;
+    size_t journalRecords = 0;
+    bool writeFailed      = false;
+
+    // Guards everything above
+    std::mutex mutex;
+    std::condition_variable compactWake;
+    std::thread compactor;
+    bool compactRequested = false;
+    bool stopping         = false;
+
+    // Held for a whole compaction, and only compactions touch what's below it. They write the bank
+    // file without holding mutex, so every use of the file goes through fileMutex
+    std::mutex compactMutex;
+    std::mutex fileMutex;
+    u32 indexCapacity = 0;
+    u32 indexOffset   = 0;
+    u32 fileEnd       = 0;
+    u16 indexChecksum = 0;
+    // Unused extents by offset
+    std::map<u32, u32> freeExtents;
+
+    // What a compaction writes, copied under mutex
+    struct Snapshot
+    {
+        std::vector<BoxEntry> boxIndex;
+        std::vector<PageEntry> pageIndex;
+        std::vector<std::pair<size_t, std::unique_ptr<u8[]>>> pages;
+        bool indexDirty       = false;
+        size_t journalRecords = 0;
+        std::vector<u32> releasedRecords;
+        // Where the new index went
+        u32 indexCapacity = 0;
+        u32 indexOffset   = 0;
+        u16 indexChecksum = 0;
+        // Extents taken, and ones given up once the header is on disk
+        std::vector<std::pair<u32, u32>> allocatedExtents;
+        std::vector<std::pair<u32, u32>> releasedExtents;
+        bool headerWritten = false;
+    };
+
+    void create();
+    void convert(pksm::Span<const u8> slots);
+    void replaceOriginal(const std::string& backupPath);
+    void readHeader(pksm::Storage& storage);
+    void findFreeExtents();
+    void replayJournal();
+    void compactLoop();
+    Page& page(size_t page);
+    void evict();
+    void applySlot(size_t box, size_t slot, const u8* data);
+    u32 findRecord(u64 hash, const u8* data);
+    u32 storeRecord(u64 hash, const u8* data);
+    void releaseRecord(u32 record);
+    void appendBox();
+    void appendPage();
+    u32 allocateExtent(u32 size);
+    void freeExtent(u32 offset, u32 size);
+    void trimFile();
+    void appendJournal(size_t box, size_t slot, const u8* data);
+    bool anyDirty() const;
+    bool writeFile(u32 offset, const u8* data, size_t length);
+    bool syncFile();
+    bool writePages(Snapshot& snapshot);
+    bool writeIndex(Snapshot& snapshot);
+    bool writeHeader(const Snapshot& snapshot);
+};
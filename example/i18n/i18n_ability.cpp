@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> abilities;
+    std::unordered_map<pksm::Language, std::vector<std::string>> abilities =
+        perLanguage<std::vector<std::string>>();
 
     void initAbility(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/abilities.txt", vec);
-        abilities.insert_or_assign(lang, std::move(vec));
+        abilities[lang] = std::move(vec);
     }
 
-    void exitAbility(pksm::Language lang) { abilities.erase(lang); }
+    void exitAbility(pksm::Language lang) { abilities[lang] = {}; }
 
     const std::string& ability(pksm::Language lang, pksm::Ability val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ability);
         if (abilities.count(lang) > 0)
         {
             if (size_t(val) < abilities[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawAbilities(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ability);
         if (abilities.count(lang) > 0)
         {
             return abilities[lang];
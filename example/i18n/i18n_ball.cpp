@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> balls;
+    std::unordered_map<pksm::Language, std::vector<std::string>> balls =
+        perLanguage<std::vector<std::string>>();
 
     void initBall(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/balls.txt", vec);
-        balls.insert_or_assign(lang, std::move(vec));
+        balls[lang] = std::move(vec);
     }
 
-    void exitBall(pksm::Language lang) { balls.erase(lang); }
+    void exitBall(pksm::Language lang) { balls[lang] = {}; }
 
     const std::string& ball(pksm::Language lang, pksm::Ball val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ball);
         if (balls.count(lang) > 0)
         {
             if (size_t(val) < balls[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawBalls(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ball);
         if (balls.count(lang) > 0)
         {
             return balls[lang];
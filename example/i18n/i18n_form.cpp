@@ -29,19 +29,21 @@
 #include "i18n_internal.hpp"
 #include "personal/personal.hpp"
 #include "utils/VersionTables.hpp"
+#include <algorithm>
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> formss;
+    std::unordered_map<pksm::Language, std::vector<std::string>> formss =
+        perLanguage<std::vector<std::string>>();
 
     void initForm(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/forms.txt", vec);
-        formss.insert_or_assign(lang, std::move(vec));
+        formss[lang] = std::move(vec);
     }
 
-    void exitForm(pksm::Language lang) { formss.erase(lang); }
+    void exitForm(pksm::Language lang) { formss[lang] = {}; }
 
     static constexpr size_t Default          = 0;
     static constexpr size_t Alolan           = 1;
@@ -252,500 +254,381 @@ namespace i18n
     static constexpr size_t RapidStrike      = 206;
     static constexpr size_t Dada             = 207;
 
-    const std::vector<size_t> formIndices(pksm::GameVersion version, pksm::Species species)
+    template <size_t... indices>
+    static constexpr u8 indexTable[] = {u8(indices)...};
+
+    // The first count of the given indices, from a table that's built at compile time
+    template <size_t... indices>
+    static pksm::Span<const u8> take(u8 count)
+    {
+        static_assert(((indices <= 0xFF) && ...));
+        return pksm::Span<const u8>(
+            indexTable<indices...>, std::min(sizeof...(indices), size_t(count)));
+    }
+
+    pksm::Span<const u8> formIndices(pksm::GameVersion version, pksm::Species species)
     {
         // TODO: Gigantamax and Isle of Armor Galarian additions, including Slowbro
         u8 forms = pksm::VersionTables::formCount(version, species);
         if (forms == 1)
         {
-            return {Default};
+            return take<Default>(forms);
         }
-        std::vector<size_t> ret;
         switch (species)
         {
             case pksm::Species::Venusaur:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Charizard:
-                ret = {Default, MegaX, MegaY};
-                break;
+                return take<Default, MegaX, MegaY>(forms);
             case pksm::Species::Blastoise:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Beedrill:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Pidgeot:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Rattata:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Raticate:
-                ret = {Default, Alolan, Totem};
-                break;
+                return take<Default, Alolan, Totem>(forms);
             case pksm::Species::Pikachu:
                 switch ((pksm::Generation)version)
                 {
                     case pksm::Generation::SIX:
-                        ret = {Default, RockStar, Belle, PopStar, PhD, Libre, Cosplay};
-                        break;
+                        return take<Default, RockStar, Belle, PopStar, PhD, Libre, Cosplay>(forms);
                     case pksm::Generation::SEVEN:
                     case pksm::Generation::LGPE:
-                        ret = {Default, Original, Hoenn, Sinnoh, Unova, Kalos, Alola, Partner,
-                            Default, World};
-                        break;
+                        return take<Default, Original, Hoenn, Sinnoh, Unova, Kalos, Alola, Partner,
+                            Default, World>(forms);
                     default:
                         break;
                 }
                 break;
             case pksm::Species::Raichu:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Sandshrew:
             case pksm::Species::Sandslash:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Vulpix:
             case pksm::Species::Ninetales:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Diglett:
             case pksm::Species::Dugtrio:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Meowth:
-                ret = {Default, Alolan, Galarian};
-                break;
+                return take<Default, Alolan, Galarian>(forms);
             case pksm::Species::Persian:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Alakazam:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Geodude:
             case pksm::Species::Graveler:
             case pksm::Species::Golem:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Ponyta:
             case pksm::Species::Rapidash:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Slowpoke:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Slowbro:
-                ret = {Default, Mega, Galarian};
-                break;
+                return take<Default, Mega, Galarian>(forms);
             case pksm::Species::Farfetchd:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Grimer:
             case pksm::Species::Muk:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Gengar:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Exeggutor:
-                ret = {Default, Alolan};
-                break;
+                return take<Default, Alolan>(forms);
             case pksm::Species::Marowak:
-                ret = {Default, Alolan, Totem};
-                break;
+                return take<Default, Alolan, Totem>(forms);
             case pksm::Species::Weezing:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::MrMime:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Kangaskhan:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Pinsir:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Gyarados:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Aerodactyl:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Mewtwo:
-                ret = {Default, MegaX, MegaY};
-                break;
+                return take<Default, MegaX, MegaY>(forms);
             case pksm::Species::Pichu:
-                ret = {Default, SpikyEared};
-                break;
+                return take<Default, SpikyEared>(forms);
             case pksm::Species::Ampharos:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Unown:
-                ret = {A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V, W, X, Y, Z,
-                    ExclamationPoint, QuestionMark};
-                break;
+                return take<A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V, W, X,
+                    Y, Z, ExclamationPoint, QuestionMark>(forms);
             case pksm::Species::Steelix:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Scizor:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Heracross:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Corsola:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Houndoom:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Tyranitar:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Sceptile:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Blaziken:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Swampert:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Zigzagoon:
             case pksm::Species::Linoone:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Gardevoir:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Sableye:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Mawile:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Aggron:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Medicham:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Manectric:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Sharpedo:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Camerupt:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Altaria:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Castform:
-                ret = {Default, Sunny, Rainy, Snowy};
-                break;
+                return take<Default, Sunny, Rainy, Snowy>(forms);
             case pksm::Species::Banette:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Absol:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Glalie:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Salamence:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Metagross:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Latias:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Latios:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Kyogre:
-                ret = {Default, Primal};
-                break;
+                return take<Default, Primal>(forms);
             case pksm::Species::Groudon:
-                ret = {Default, Primal};
-                break;
+                return take<Default, Primal>(forms);
             case pksm::Species::Rayquaza:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Deoxys:
-                ret = {Normal, Attack, Defense, Speed};
-                break;
+                return take<Normal, Attack, Defense, Speed>(forms);
             case pksm::Species::Burmy:
-                ret = {Plant, Sandy, Trash};
-                break;
+                return take<Plant, Sandy, Trash>(forms);
             case pksm::Species::Wormadam:
-                ret = {Plant, Sandy, Trash};
-                break;
+                return take<Plant, Sandy, Trash>(forms);
             case pksm::Species::Cherrim:
-                ret = {Overcast, Sunshine};
-                break;
+                return take<Overcast, Sunshine>(forms);
             case pksm::Species::Shellos:
-                ret = {WestSea, EastSea};
-                break;
+                return take<WestSea, EastSea>(forms);
             case pksm::Species::Gastrodon:
-                ret = {WestSea, EastSea};
-                break;
+                return take<WestSea, EastSea>(forms);
             case pksm::Species::Lopunny:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Garchomp:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Lucario:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Abomasnow:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Gallade:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Rotom:
-                ret = {Default, Heat, Wash, Fridge, Fan, Mow};
-                break;
+                return take<Default, Heat, Wash, Fridge, Fan, Mow>(forms);
             case pksm::Species::Giratina:
-                ret = {Altered, Origin};
-                break;
+                return take<Altered, Origin>(forms);
             case pksm::Species::Shaymin:
-                ret = {Land, Sky};
-                break;
+                return take<Land, Sky>(forms);
             case pksm::Species::Arceus:
-                ret = {Default, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel, Fire,
-                    Water, Grass, Electric, Psychic, Ice, Dragon, Dark, Fairy};
-                break;
+                return take<Default, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel,
+                    Fire, Water, Grass, Electric, Psychic, Ice, Dragon, Dark, Fairy>(forms);
             case pksm::Species::Audino:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Basculin:
-                ret = {RedStriped, BlueStriped};
-                break;
+                return take<RedStriped, BlueStriped>(forms);
             case pksm::Species::Darumaka:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Darmanitan:
-                ret = {Default, Zen, Galarian, Zen};
-                break;
+                return take<Default, Zen, Galarian, Zen>(forms);
             case pksm::Species::Yamask:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Deerling:
             case pksm::Species::Sawsbuck:
-                ret = {Spring, Summer, Autumn, Winter};
-                break;
+                return take<Spring, Summer, Autumn, Winter>(forms);
             case pksm::Species::Stunfisk:
-                ret = {Default, Galarian};
-                break;
+                return take<Default, Galarian>(forms);
             case pksm::Species::Tornadus:
-                ret = {Incarnate, Therian};
-                break;
+                return take<Incarnate, Therian>(forms);
             case pksm::Species::Thundurus:
-                ret = {Incarnate, Therian};
-                break;
+                return take<Incarnate, Therian>(forms);
             case pksm::Species::Landorus:
-                ret = {Incarnate, Therian};
-                break;
+                return take<Incarnate, Therian>(forms);
             case pksm::Species::Kyurem:
-                ret = {Default, WhiteKyurem, Black};
-                break;
+                return take<Default, WhiteKyurem, Black>(forms);
             case pksm::Species::Keldeo:
-                ret = {Ordinary, Resolute};
-                break;
+                return take<Ordinary, Resolute>(forms);
             case pksm::Species::Meloetta:
-                ret = {Aria, Pirouette};
-                break;
+                return take<Aria, Pirouette>(forms);
             case pksm::Species::Genesect:
-                ret = {Default, Water, Electric, Fire, Ice};
-                break;
+                return take<Default, Water, Electric, Fire, Ice>(forms);
             case pksm::Species::Greninja:
-                ret = {Default, BattleBond, Ash};
-                break;
+                return take<Default, BattleBond, Ash>(forms);
             case pksm::Species::Scatterbug:
             case pksm::Species::Spewpa:
             case pksm::Species::Vivillon:
-                ret = {IcySnow, Polar, Tundra, Continental, Garden, Elegant, Meadow, Modern, Marine,
-                    Archipelago, HighPlains, Sandstorm, River, Monsoon, Savanna, Sun, Ocean, Jungle,
-                    Fancy, PokeBall};
-                break;
+                return take<IcySnow, Polar, Tundra, Continental, Garden, Elegant, Meadow, Modern,
+                    Marine, Archipelago, HighPlains, Sandstorm, River, Monsoon, Savanna, Sun, Ocean,
+                    Jungle, Fancy, PokeBall>(forms);
             case pksm::Species::Flabebe:
-                ret = {RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower};
-                break;
+                return take<RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower>(forms);
             case pksm::Species::Floette:
-                ret = {
-                    RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower, EternalFlower};
-                break;
+                return take<RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower,
+                    EternalFlower>(forms);
             case pksm::Species::Florges:
-                ret = {RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower};
-                break;
+                return take<RedFlower, YellowFlower, OrangeFlower, BlueFlower, WhiteFlower>(forms);
             case pksm::Species::Furfrou:
-                ret = {Natural, Heart, Star, Diamond, Debutante, Matron, Dandy, LaReine, Kabuki,
-                    Pharaoh};
-                break;
+                return take<Natural, Heart, Star, Diamond, Debutante, Matron, Dandy, LaReine,
+                    Kabuki, Pharaoh>(forms);
             case pksm::Species::Meowstic:
-                ret = {Default, Female};
-                break;
+                return take<Default, Female>(forms);
             case pksm::Species::Aegislash:
-                ret = {Shield, Blade};
-                break;
+                return take<Shield, Blade>(forms);
             case pksm::Species::Pumpkaboo:
-                ret = {Average, Small, Large, Super};
-                break;
+                return take<Average, Small, Large, Super>(forms);
             case pksm::Species::Gourgeist:
-                ret = {Average, Small, Large, Super};
-                break;
+                return take<Average, Small, Large, Super>(forms);
             case pksm::Species::Zygarde:
-                ret = {_50Percent, _10Percent, _10Percent_PC, _50Percent_PC, _100Percent};
-                break;
+                return take<_50Percent, _10Percent, _10Percent_PC, _50Percent_PC,
+                    _100Percent>(forms);
             case pksm::Species::Diancie:
-                ret = {Default, Mega};
-                break;
+                return take<Default, Mega>(forms);
             case pksm::Species::Hoopa:
-                ret = {Confined, Unbound};
-                break;
+                return take<Confined, Unbound>(forms);
             case pksm::Species::Gumshoos:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Vikavolt:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Oricorio:
-                ret = {Baile, PomPom, Pau, Sensu};
-                break;
+                return take<Baile, PomPom, Pau, Sensu>(forms);
             case pksm::Species::Ribombee:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Rockruff:
-                ret = {Default, Dusk};
-                break;
+                return take<Default, Dusk>(forms);
             case pksm::Species::Lycanroc:
-                ret = {Midday, Midnight, Dusk};
-                break;
+                return take<Midday, Midnight, Dusk>(forms);
             case pksm::Species::Wishiwashi:
-                ret = {Solo, School};
-                break;
+                return take<Solo, School>(forms);
             case pksm::Species::Araquanid:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Lurantis:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Salazzle:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Silvally:
-                ret = {Default, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel, Fire,
-                    Water, Grass, Electric, Psychic, Ice, Dragon, Dark, Fairy};
-                break;
+                return take<Default, Fighting, Flying, Poison, Ground, Rock, Bug, Ghost, Steel,
+                    Fire, Water, Grass, Electric, Psychic, Ice, Dragon, Dark, Fairy>(forms);
             case pksm::Species::Minior:
-                ret = {CoveredRed, CoveredOrange, CoveredYellow, CoveredGreen, CoveredBlue,
-                    CoveredIndigo, CoveredViolet, Red, Orange, Yellow, Green, Blue, Indigo, Violet};
-                break;
+                return take<CoveredRed, CoveredOrange, CoveredYellow, CoveredGreen, CoveredBlue,
+                    CoveredIndigo, CoveredViolet, Red, Orange, Yellow, Green, Blue, Indigo,
+                    Violet>(forms);
             case pksm::Species::Togedemaru:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Mimikyu:
-                ret = {Default, Default, Totem, Totem};
-                break;
+                return take<Default, Default, Totem, Totem>(forms);
             case pksm::Species::Kommoo:
-                ret = {Default, Totem};
-                break;
+                return take<Default, Totem>(forms);
             case pksm::Species::Necrozma:
-                ret = {Default, DawnWings, DuskMane, Ultra};
-                break;
+                return take<Default, DawnWings, DuskMane, Ultra>(forms);
             case pksm::Species::Magearna:
-                ret = {Default, OriginalColor};
-                break;
+                return take<Default, OriginalColor>(forms);
             case pksm::Species::Cramorant:
-                ret = {Default, Gulping, Gorging};
-                break;
+                return take<Default, Gulping, Gorging>(forms);
             case pksm::Species::Toxtricity:
-                ret = {AmpedForm, LowKey};
-                break;
+                return take<AmpedForm, LowKey>(forms);
             case pksm::Species::Indeedee:
-                ret = {Default, Female};
-                break;
+                return take<Default, Female>(forms);
             case pksm::Species::Sinistea:
             case pksm::Species::Polteageist:
-                ret = {Phony, Antique};
-                break;
+                return take<Phony, Antique>(forms);
             case pksm::Species::Alcremie:
-                ret = {VanillaCream, RubyCream, MatchaCream, MintCream, LemonCream, SaltedCream,
-                    RubySwirl, CaramelSwirl, RainbowSwirl};
-                break;
+                return take<VanillaCream, RubyCream, MatchaCream, MintCream, LemonCream,
+                    SaltedCream, RubySwirl, CaramelSwirl, RainbowSwirl>(forms);
             case pksm::Species::Morpeko:
-                ret = {Default, HangryMode};
-                break;
+                return take<Default, HangryMode>(forms);
             case pksm::Species::Eiscue:
-                ret = {Default, NoiceFace};
-                break;
+                return take<Default, NoiceFace>(forms);
             case pksm::Species::Zacian:
-                ret = {Default, Crowned};
-                break;
+                return take<Default, Crowned>(forms);
             case pksm::Species::Zamazenta:
-                ret = {Default, Crowned};
-                break;
+                return take<Default, Crowned>(forms);
             case pksm::Species::Eternatus:
-                ret = {Default, Eternamax};
-                break;
+                return take<Default, Eternamax>(forms);
             case pksm::Species::Urshifu:
-                ret = {SingleStrike, RapidStrike};
-                break;
+                return take<SingleStrike, RapidStrike>(forms);
             case pksm::Species::Zarude:
-                ret = {Default, Dada};
-                break;
+                return take<Default, Dada>(forms);
             default:
-                ret = {Default};
-                break;
+                return take<Default>(forms);
         }
 
-        while (ret.size() > forms)
-        {
-            ret.pop_back();
-        }
-
-        return ret;
+        return {};
     }
 
     const std::string& form(
         pksm::Language lang, pksm::GameVersion version, pksm::Species species, u8 form)
     {
-        checkInitialized(lang);
-        if (formss.count(lang) > 0)
+        checkInitialized(lang, Category::Form);
+        auto found = formss.find(lang);
+        if (found != formss.end())
         {
-            auto indices = formIndices(version, species);
-            if (form < indices.size())
+            pksm::Span<const u8> indices = formIndices(version, species);
+            if (form < indices.size() && indices[form] < found->second.size())
             {
-                size_t index = indices[form];
-                if (index < formss[lang].size())
-                {
-                    return formss[lang][index];
-                }
+                return found->second[indices[form]];
             }
         }
         return emptyString;
     }
 
+    const std::vector<std::string>& rawForms(pksm::Language lang)
+    {
+        checkInitialized(lang, Category::Form);
+        auto found = formss.find(lang);
+        if (found != formss.end())
+        {
+            return found->second;
+        }
+        return emptyVector;
+    }
+
     std::vector<std::string> forms(
         pksm::Language lang, pksm::GameVersion version, pksm::Species species)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Form);
         std::vector<std::string> ret;
-        if (formss.count(lang) > 0)
+        auto found = formss.find(lang);
+        if (found != formss.end())
         {
-            auto indices = formIndices(version, species);
-            for (const auto& index : indices)
+            pksm::Span<const u8> indices = formIndices(version, species);
+            ret.reserve(indices.size());
+            for (u8 index : indices)
             {
-                if (index < formss[lang].size())
+                if (index < found->second.size())
                 {
-                    ret.emplace_back(formss[lang][index]);
+                    ret.emplace_back(found->second[index]);
                 }
                 else
                 {
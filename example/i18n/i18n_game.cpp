@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> games;
+    std::unordered_map<pksm::Language, std::vector<std::string>> games =
+        perLanguage<std::vector<std::string>>();
 
     void initGame(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/games.txt", vec);
-        games.insert_or_assign(lang, std::move(vec));
+        games[lang] = std::move(vec);
     }
 
-    void exitGame(pksm::Language lang) { games.erase(lang); }
+    void exitGame(pksm::Language lang) { games[lang] = {}; }
 
     const std::string& game(pksm::Language lang, pksm::GameVersion val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Game);
         if (games.count(lang) > 0)
         {
             if (u8(val) < games[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawGames(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Game);
         if (games.count(lang) > 0)
         {
             return games[lang];
@@ -28,8 +28,10 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::map<u8, std::string>> countries;
-    std::unordered_map<pksm::Language, std::map<u8, std::map<u8, std::string>>> subregions;
+    std::unordered_map<pksm::Language, FlatMap<u8>> countries = perLanguage<FlatMap<u8>>();
+    // Each country's subregions, sorted by country
+    std::unordered_map<pksm::Language, std::vector<std::pair<u8, FlatMap<u8>>>> subregions =
+        perLanguage<std::vector<std::pair<u8, FlatMap<u8>>>>();
 
     std::string subregionFileName(u8 region)
     {
@@ -45,74 +47,83 @@ namespace i18n
 
     void initGeo(pksm::Language lang)
     {
-        std::map<u8, std::string> tmp;
+        FlatMap<u8> tmp;
         load(lang, "/countries.txt", tmp);
-        countries.insert_or_assign(lang, std::move(tmp));
 
-        std::map<u8, std::map<u8, std::string>> tmp2;
-        for (auto i = tmp.begin(); i != tmp.end(); i++)
+        std::vector<std::pair<u8, FlatMap<u8>>> tmp2;
+        tmp2.reserve(tmp.size());
+        for (const auto& country : tmp)
         {
-            tmp2[i->first] = {};
-            load(lang, subregionFileName(i->first), tmp2[i->first]);
+            tmp2.emplace_back(country.first, FlatMap<u8>{});
+            load(lang, subregionFileName(country.first), tmp2.back().second);
         }
-        subregions.insert_or_assign(lang, std::move(tmp2));
+
+        countries[lang]  = std::move(tmp);
+        subregions[lang] = std::move(tmp2);
     }
 
     void exitGeo(pksm::Language lang)
     {
-        countries.erase(lang);
-        subregions.erase(lang);
+        countries[lang]  = {};
+        subregions[lang] = {};
     }
 
-    const std::string& subregion(pksm::Language lang, u8 country, u8 v)
+    static const FlatMap<u8>* subregionTable(pksm::Language lang, u8 country)
     {
-        checkInitialized(lang);
-        if (subregions.count(lang) > 0)
+        auto found = subregions.find(lang);
+        if (found != subregions.end())
         {
-            if (subregions[lang].count(country) > 0)
+            auto table = std::lower_bound(found->second.begin(), found->second.end(), country,
+                [](const std::pair<u8, FlatMap<u8>>& entry, u8 country) {
+                    return entry.first < country;
+                });
+            if (table != found->second.end() && table->first == country)
             {
-                if (subregions[lang][country].count(v) > 0)
-                {
-                    return subregions[lang][country][v];
-                }
+                return &table->second;
             }
         }
+        return nullptr;
+    }
+
+    const std::string& subregion(pksm::Language lang, u8 country, u8 v)
+    {
+        checkInitialized(lang, Category::Geo);
+        if (const FlatMap<u8>* table = subregionTable(lang, country))
+        {
+            return find(*table, v);
+        }
         return emptyString;
     }
 
     const std::string& country(pksm::Language lang, u8 v)
     {
-        checkInitialized(lang);
-        if (countries.count(lang) > 0)
+        checkInitialized(lang, Category::Geo);
+        auto found = countries.find(lang);
+        if (found != countries.end())
         {
-            if (countries[lang].count(v) > 0)
-            {
-                return countries[lang][v];
-            }
+            return find(found->second, v);
         }
         return emptyString;
     }
 
-    const std::map<u8, std::string>& rawCountries(pksm::Language lang)
+    SortedStrings<u8> rawCountries(pksm::Language lang)
     {
-        checkInitialized(lang);
-        if (countries.count(lang) > 0)
+        checkInitialized(lang, Category::Geo);
+        auto found = countries.find(lang);
+        if (found != countries.end())
         {
-            return countries[lang];
+            return SortedStrings<u8>(found->second.data(), found->second.size());
         }
-        return emptyU8Map;
+        return {};
     }
 
-    const std::map<u8, std::string>& rawSubregions(pksm::Language lang, u8 country)
+    SortedStrings<u8> rawSubregions(pksm::Language lang, u8 country)
     {
-        checkInitialized(lang);
-        if (subregions.count(lang) > 0)
+        checkInitialized(lang, Category::Geo);
+        if (const FlatMap<u8>* table = subregionTable(lang, country))
         {
-            if (subregions[lang].count(country) > 0)
-            {
-                return subregions[lang][country];
-            }
+            return SortedStrings<u8>(table->data(), table->size());
         }
-        return emptyU8Map;
+        return {};
     }
 }
@@ -28,12 +28,14 @@
 #define I18N_INTERNAL_HPP
 
 #include "enums/Language.hpp"
+#include "i18n/i18n_table.hpp"
 #include "utils/coretypes.h"
 #include "utils/i18n.hpp"
 #include "utils/io.hpp"
+#include <algorithm>
 #include <atomic>
-#include <time.h>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _PKSMCORE_CONFIGURED
 #include "PKSMCORE_CONFIG.h"
@@ -52,43 +54,134 @@ namespace i18n
         INITIALIZED
     };
 
-    inline const std::string emptyString                = "";
-    inline const std::vector<std::string> emptyVector   = {};
-    inline const std::map<u16, std::string> emptyU16Map = {};
-    inline const std::map<u8, std::string> emptyU8Map   = {};
+    inline const std::string emptyString              = "";
+    inline const std::vector<std::string> emptyVector = {};
+
+    // What location and geo strings are kept in: sorted by value, so lookups are a binary search
+    template <typename T>
+    using FlatMap = std::vector<std::pair<T, std::string>>;
+
+    template <typename T>
+    const std::string& find(const FlatMap<T>& map, T value)
+    {
+        auto found = std::lower_bound(map.begin(), map.end(), value,
+            [](const std::pair<T, std::string>& entry, T value) { return entry.first < value; });
+        if (found != map.end() && found->first == value)
+        {
+            return found->second;
+        }
+        return emptyString;
+    }
+
+    // Every language strings can be loaded for. Safe to call during static initialization
+    const std::vector<pksm::Language>& supportedLanguages();
+
+    // A map with an entry for every language from the start. What each category loads lives in one
+    // of these: init callbacks only assign to their language's entry and exit callbacks only clear
+    // it, so the map never rehashes while a getter on another thread looks up a different language
+    template <typename T>
+    std::unordered_map<pksm::Language, T> perLanguage()
+    {
+        std::unordered_map<pksm::Language, T> ret;
+        for (pksm::Language lang : supportedLanguages())
+        {
+            ret[lang];
+        }
+        return ret;
+    }
+
+    // The strings the default init callbacks load, one category per callback. Each is loaded on its
+    // own the first time one of its getters is called
+    enum class Category : u8
+    {
+        Ability,
+        Ball,
+        Form,
+        Game,
+        Geo,
+        Type,
+        Item,
+        Item3,
+        Location,
+        Move,
+        Nature,
+        Ribbon,
+        Species,
+        COUNT
+    };
 
 #ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
-    extern std::unordered_map<pksm::Language, LangState> languages;
+    using StateFlag = LangState;
 #else
-    extern std::unordered_map<pksm::Language, std::atomic<LangState>> languages;
+    using StateFlag = std::atomic<LangState>;
 #endif
 
-    inline void checkInitialized(pksm::Language lang)
+    struct LangStates
+    {
+        LangStates()
+        {
+            for (auto& category : categories)
+            {
+                category = LangState::UNINITIALIZED;
+            }
+        }
+
+        // Of the callbacks added with addInitCallback, which run together
+        StateFlag custom{LangState::UNINITIALIZED};
+        StateFlag categories[size_t(Category::COUNT)];
+    };
+
+    extern std::unordered_map<pksm::Language, LangStates> languages;
+
+    // Runs category's init callback for lang unless that's been done already, or the callback has
+    // been removed. If another thread is running it, waits for that one to finish instead
+    void loadCategory(pksm::Language lang, Category category);
+    // The same for the init callbacks that aren't one of the defaults
+    void loadCustom(pksm::Language lang);
+
+    inline void checkInitialized(pksm::Language lang, Category category)
     {
         auto found = languages.find(lang);
         if (found == languages.end())
         {
             found = languages.find(pksm::Language::ENG);
         }
-        if (found->second == LangState::UNINITIALIZED)
+        // Not waited for, so a custom callback can call getters itself
+        if (found->second.custom == LangState::UNINITIALIZED)
         {
-            i18n::init(found->first);
+            loadCustom(found->first);
         }
-#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
-        while (found->second != LangState::INITIALIZED)
+        if (found->second.categories[size_t(category)] != LangState::INITIALIZED)
         {
-            timespec time = {0, 100000};
-            nanosleep(&time, nullptr);
+            loadCategory(found->first, category);
         }
-#endif
     }
 
     std::string folder(pksm::Language lang);
 
+    // The packed list or map that load would read name (a path starting with '/') from: lang's
+    // table if it has the file, English's otherwise, like the text files. Falsy if lang has no
+    // table, so load goes to the text files. Only valid while holder is kept
+    StringTable::List packedList(pksm::Language lang, const std::string& name,
+        std::shared_ptr<const StringTable>& holder);
+    StringTable::Map packedMap(pksm::Language lang, const std::string& name,
+        std::shared_ptr<const StringTable>& holder);
+
     void load(pksm::Language lang, const std::string& name, std::vector<std::string>& array);
     template <typename T>
     void load(pksm::Language lang, const std::string& name, std::map<T, std::string>& map)
     {
+        std::shared_ptr<const StringTable> holder;
+        if (StringTable::Map packed = packedMap(lang, name, holder))
+        {
+            // Keys come sorted, so each one goes at the end
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                map.insert_or_assign(map.end(), T(packed.key(i)), std::string(packed.value(i)));
+            }
+            return;
+        }
+
         std::string path = io::exists(_PKSMCORE_LANG_FOLDER + folder(lang) + name)
                                ? _PKSMCORE_LANG_FOLDER + folder(lang) + name
                                : _PKSMCORE_LANG_FOLDER + folder(pksm::Language::ENG) + name;
@@ -125,6 +218,31 @@ namespace i18n
             free(data);
         }
     }
+
+    template <typename T>
+    void load(pksm::Language lang, const std::string& name, FlatMap<T>& flat)
+    {
+        std::shared_ptr<const StringTable> holder;
+        if (StringTable::Map packed = packedMap(lang, name, holder))
+        {
+            // Already sorted by key, so it's copied straight across
+            flat.reserve(flat.size() + packed.size());
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                flat.emplace_back(T(packed.key(i)), std::string(packed.value(i)));
+            }
+            return;
+        }
+
+        // The text files can list a value more than once and in any order, which the map sorts out
+        std::map<T, std::string> map;
+        load(lang, name, map);
+        flat.reserve(flat.size() + map.size());
+        for (auto& entry : map)
+        {
+            flat.emplace_back(entry.first, std::move(entry.second));
+        }
+    }
 }
 
 #endif
@@ -28,8 +28,10 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> items;
-    std::unordered_map<pksm::Language, std::vector<std::string>> items3;
+    std::unordered_map<pksm::Language, std::vector<std::string>> items =
+        perLanguage<std::vector<std::string>>();
+    std::unordered_map<pksm::Language, std::vector<std::string>> items3 =
+        perLanguage<std::vector<std::string>>();
 
     void initItem(pksm::Language lang)
     {
@@ -39,23 +41,23 @@ namespace i18n
         // HM07 & HM08
         vec[426] = vec[425].substr(0, vec[425].size() - 1) + '7';
         vec[427] = vec[425].substr(0, vec[425].size() - 1) + '8';
-        items.insert_or_assign(lang, std::move(vec));
+        items[lang] = std::move(vec);
     }
 
     void initItem3(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/items3.txt", vec);
-        items3.insert_or_assign(lang, std::move(vec));
+        items3[lang] = std::move(vec);
     }
 
-    void exitItem(pksm::Language lang) { items.erase(lang); }
+    void exitItem(pksm::Language lang) { items[lang] = {}; }
 
-    void exitItem3(pksm::Language lang) { items3.erase(lang); }
+    void exitItem3(pksm::Language lang) { items3[lang] = {}; }
 
     const std::string& item(pksm::Language lang, u16 val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Item);
         if (items.count(lang) > 0)
         {
             if (val < items[lang].size())
@@ -68,7 +70,7 @@ namespace i18n
 
     const std::string& item3(pksm::Language lang, u16 val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Item3);
         if (items3.count(lang) > 0)
         {
             if (val < items3[lang].size())
@@ -81,7 +83,7 @@ namespace i18n
 
     const std::vector<std::string>& rawItems(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Item);
         if (items.count(lang) > 0)
         {
             return items[lang];
@@ -91,7 +93,7 @@ namespace i18n
 
     const std::vector<std::string>& rawItems3(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Item3);
         if (items3.count(lang) > 0)
         {
             return items3[lang];
@@ -31,16 +31,16 @@ namespace i18n
 {
     struct Locations
     {
-        std::map<u16, std::string> locations3;
-        std::map<u16, std::string> locations4;
-        std::map<u16, std::string> locations5;
-        std::map<u16, std::string> locations6;
-        std::map<u16, std::string> locations7;
-        std::map<u16, std::string> locationsLGPE;
-        std::map<u16, std::string> locations8;
+        FlatMap<u16> locations3;
+        FlatMap<u16> locations4;
+        FlatMap<u16> locations5;
+        FlatMap<u16> locations6;
+        FlatMap<u16> locations7;
+        FlatMap<u16> locationsLGPE;
+        FlatMap<u16> locations8;
     };
 
-    std::unordered_map<pksm::Language, Locations> locationss;
+    std::unordered_map<pksm::Language, Locations> locationss = perLanguage<Locations>();
 
     void initLocation(pksm::Language lang)
     {
@@ -52,96 +52,62 @@ namespace i18n
         load(lang, "/locations7.txt", tmp.locations7);
         load(lang, "/locationsLGPE.txt", tmp.locationsLGPE);
         load(lang, "/locations8.txt", tmp.locations8);
-        locationss.insert_or_assign(lang, std::move(tmp));
+        locationss[lang] = std::move(tmp);
     }
 
-    void exitLocation(pksm::Language lang) { locationss.erase(lang); }
+    void exitLocation(pksm::Language lang) { locationss[lang] = {}; }
+
+    static const FlatMap<u16>* locationTable(const Locations& locations, pksm::Generation gen)
+    {
+        switch (gen)
+        {
+            case pksm::Generation::THREE:
+                return &locations.locations3;
+            case pksm::Generation::FOUR:
+                return &locations.locations4;
+            case pksm::Generation::FIVE:
+                return &locations.locations5;
+            case pksm::Generation::SIX:
+                return &locations.locations6;
+            case pksm::Generation::SEVEN:
+                return &locations.locations7;
+            case pksm::Generation::LGPE:
+                return &locations.locationsLGPE;
+            case pksm::Generation::EIGHT:
+                return &locations.locations8;
+            case pksm::Generation::UNUSED:
+            case pksm::Generation::ONE:
+            case pksm::Generation::TWO:
+                break;
+        }
+        return nullptr;
+    }
 
     const std::string& location(pksm::Language lang, pksm::Generation gen, u16 v)
     {
-        checkInitialized(lang);
-        if (locationss.count(lang) > 0)
+        checkInitialized(lang, Category::Location);
+        auto found = locationss.find(lang);
+        if (found != locationss.end())
         {
-            switch (gen)
+            if (const FlatMap<u16>* table = locationTable(found->second, gen))
             {
-                case pksm::Generation::THREE:
-                    if (locationss[lang].locations3.count(v) > 0)
-                    {
-                        return locationss[lang].locations3[v];
-                    }
-                    break;
-                case pksm::Generation::FOUR:
-                    if (locationss[lang].locations4.count(v) > 0)
-                    {
-                        return locationss[lang].locations4[v];
-                    }
-                    break;
-                case pksm::Generation::FIVE:
-                    if (locationss[lang].locations5.count(v) > 0)
-                    {
-                        return locationss[lang].locations5[v];
-                    }
-                    break;
-                case pksm::Generation::SIX:
-                    if (locationss[lang].locations6.count(v) > 0)
-                    {
-                        return locationss[lang].locations6[v];
-                    }
-                    break;
-                case pksm::Generation::SEVEN:
-                    if (locationss[lang].locations7.count(v) > 0)
-                    {
-                        return locationss[lang].locations7[v];
-                    }
-                    break;
-                case pksm::Generation::LGPE:
-                    if (locationss[lang].locationsLGPE.count(v) > 0)
-                    {
-                        return locationss[lang].locationsLGPE[v];
-                    }
-                    break;
-                case pksm::Generation::EIGHT:
-                    if (locationss[lang].locations8.count(v) > 0)
-                    {
-                        return locationss[lang].locations8[v];
-                    }
-                    break;
-                case pksm::Generation::UNUSED:
-                case pksm::Generation::ONE:
-                case pksm::Generation::TWO:
-                    break;
+                return find(*table, v);
             }
         }
         return emptyString;
     }
 
-    const std::map<u16, std::string>& rawLocations(pksm::Language lang, pksm::Generation g)
+    SortedStrings<u16> rawLocations(pksm::Language lang, pksm::Generation gen)
     {
-        checkInitialized(lang);
-        if (locationss.count(lang) > 0)
+        checkInitialized(lang, Category::Location);
+        auto found = locationss.find(lang);
+        if (found != locationss.end())
         {
-            switch (g)
+            if (const FlatMap<u16>* table = locationTable(found->second, gen))
             {
-                case pksm::Generation::THREE:
-                    return locationss[lang].locations3;
-                case pksm::Generation::FOUR:
-                    return locationss[lang].locations4;
-                case pksm::Generation::FIVE:
-                    return locationss[lang].locations5;
-                case pksm::Generation::SIX:
-                    return locationss[lang].locations6;
-                case pksm::Generation::SEVEN:
-                    return locationss[lang].locations7;
-                case pksm::Generation::LGPE:
-                    return locationss[lang].locationsLGPE;
-                case pksm::Generation::EIGHT:
-                    return locationss[lang].locations8;
-                case pksm::Generation::UNUSED:
-                case pksm::Generation::ONE:
-                case pksm::Generation::TWO:
-                    break;
+                return SortedStrings<u16>(table->data(), table->size());
             }
         }
-        return emptyU16Map;
+        return {};
     }
 }
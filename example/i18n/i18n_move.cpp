@@ -28,20 +28,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> moves;
+    std::unordered_map<pksm::Language, std::vector<std::string>> moves =
+        perLanguage<std::vector<std::string>>();
 
     void initMove(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/moves.txt", vec);
-        moves.insert_or_assign(lang, std::move(vec));
+        moves[lang] = std::move(vec);
     }
 
-    void exitMove(pksm::Language lang) { moves.erase(lang); }
+    void exitMove(pksm::Language lang) { moves[lang] = {}; }
 
     const std::string& move(pksm::Language lang, pksm::Move val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Move);
         if (moves.count(lang) > 0)
         {
             if (size_t(val) < moves[lang].size())
@@ -54,7 +55,7 @@ namespace i18n
 
     const std::vector<std::string>& rawMoves(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Move);
         if (moves.count(lang) > 0)
         {
             return moves[lang];
@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> natures;
+    std::unordered_map<pksm::Language, std::vector<std::string>> natures =
+        perLanguage<std::vector<std::string>>();
 
     void initNature(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/natures.txt", vec);
-        natures.insert_or_assign(lang, std::move(vec));
+        natures[lang] = std::move(vec);
     }
 
-    void exitNature(pksm::Language lang) { natures.erase(lang); }
+    void exitNature(pksm::Language lang) { natures[lang] = {}; }
 
     const std::string& nature(pksm::Language lang, pksm::Nature val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Nature);
         if (natures.count(lang) > 0)
         {
             if (size_t(val) < natures[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawNatures(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Nature);
         if (natures.count(lang) > 0)
         {
             return natures[lang];
@@ -29,15 +29,22 @@
 #include "utils/utils.hpp"
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <list>
 
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 #ifdef _PKSMCORE_EXTRA_LANGUAGES
 #define LANGUAGES_TO_USE JPN, ENG, FRE, ITA, GER, SPA, KOR, CHS, CHT, _PKSMCORE_EXTRA_LANGUAGES
 #else
 #define LANGUAGES_TO_USE JPN, ENG, FRE, ITA, GER, SPA, KOR, CHS, CHT
 #endif
 
-#define MAKE_MAP(lang) ret.emplace(pksm::Language::lang, LangState::UNINITIALIZED);
+#define TO_LIST_ENTRY(lang) pksm::Language::lang,
 #define TO_STRING_CASE(lang)                                                                       \
     case pksm::Language::lang:                                                                     \
     {                                                                                              \
@@ -53,70 +60,313 @@
 
 namespace i18n
 {
-#ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
-    std::unordered_map<pksm::Language, LangState> languages = std::invoke([]() {
-        std::unordered_map<pksm::Language, LangState> ret;
-        MAP(MAKE_MAP, LANGUAGES_TO_USE);
-        return ret;
-    });
-#else
-    std::unordered_map<pksm::Language, std::atomic<LangState>> languages = std::invoke([]() {
-        std::unordered_map<pksm::Language, std::atomic<LangState>> ret;
-        MAP(MAKE_MAP, LANGUAGES_TO_USE);
+    const std::vector<pksm::Language>& supportedLanguages()
+    {
+        static const std::vector<pksm::Language> ret = {MAP(TO_LIST_ENTRY, LANGUAGES_TO_USE)};
         return ret;
-    });
-#endif
+    }
+
+    std::unordered_map<pksm::Language, LangStates> languages = perLanguage<LangStates>();
 
     std::list<initCallback> initCallbacks = {initAbility, initBall, initForm, initGame, initGeo,
         initType, initItem, initItem3, initLocation, initMove, initNature, initRibbon, initSpecies};
     std::list<exitCallback> exitCallbacks = {exitAbility, exitBall, exitForm, exitGame, exitGeo,
-        exitType, exitItem, exitItem3, exitLocation, exitMove, exitNature, exitRibbon, exitSpecies};
+        exitType, exitItem, exitItem3, exitLocation, exitMove, exitNature, exitRibbon, exitSpecies,
+        exitTable};
 
-    void init(pksm::Language lang)
+    namespace
     {
-        auto found = languages.find(lang);
-        // Should never happen, but might as well check
-        if (found == languages.end())
+        // In the order of Category
+        constexpr initCallback categoryInits[] = {initAbility, initBall, initForm, initGame,
+            initGeo, initType, initItem, initItem3, initLocation, initMove, initNature, initRibbon,
+            initSpecies};
+        static_assert(std::size(categoryInits) == size_t(Category::COUNT));
+
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        // Every change to or from INITIALIZING is made under stateMutex and followed by a
+        // notification, so waiters can sleep on stateChanged
+        std::mutex stateMutex;
+        std::condition_variable stateChanged;
+        // Guards initCallbacks, which getters on any thread read
+        std::mutex callbackMutex;
+
+        // Preload threads that haven't been joined yet. exit joins them before it unloads anything,
+        // and so does the end of the program if exit is never called
+        struct PreloadThreads
         {
-            found = languages.find(pksm::Language::ENG);
+            std::mutex mutex;
+            std::vector<std::thread> threads;
+
+            ~PreloadThreads() { joinAll(); }
+
+            void add(std::thread thread)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.emplace_back(std::move(thread));
+            }
+
+            void joinAll()
+            {
+                std::vector<std::thread> running;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    running.swap(threads);
+                }
+                for (auto& thread : running)
+                {
+                    thread.join();
+                }
+            }
+        } preloadThreads;
+#endif
+
+        bool isDefault(initCallback callback)
+        {
+            return std::find(std::begin(categoryInits), std::end(categoryInits), callback) !=
+                   std::end(categoryInits);
+        }
+
+        std::list<initCallback> currentInitCallbacks()
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::lock_guard<std::mutex> lock(callbackMutex);
+#endif
+            return initCallbacks;
+        }
+
+        bool registered(initCallback callback)
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            std::lock_guard<std::mutex> lock(callbackMutex);
+#endif
+            return std::find(initCallbacks.begin(), initCallbacks.end(), callback) !=
+                   initCallbacks.end();
         }
+
+        bool used(const LangStates& states)
+        {
+            if (states.custom != LangState::UNINITIALIZED)
+            {
+                return true;
+            }
+            for (const auto& category : states.categories)
+            {
+                if (category != LangState::UNINITIALIZED)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
 #ifdef _PKSMCORE_DISABLE_THREAD_SAFETY
-        if (found->second == LangState::UNINITIALIZED)
+        template <typename Load>
+        void loadOnce(StateFlag& state, Load load)
         {
-            found->second = LangState::INITIALIZING;
+            if (state == LangState::UNINITIALIZED)
+            {
+                state = LangState::INITIALIZING;
+                try
+                {
+                    load();
+                }
+                catch (...)
+                {
+                    state = LangState::UNINITIALIZED;
+                    throw;
+                }
+                state = LangState::INITIALIZED;
+            }
+        }
 #else
-        LangState expected = LangState::UNINITIALIZED;
-        if (found->second.compare_exchange_strong(expected, LangState::INITIALIZING))
+        bool busy(const LangStates& states)
+        {
+            if (states.custom == LangState::INITIALIZING)
+            {
+                return true;
+            }
+            for (const auto& category : states.categories)
+            {
+                if (category == LangState::INITIALIZING)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void setState(StateFlag& state, LangState value)
         {
-#endif
-            for (const auto& callback : initCallbacks)
             {
-                callback(lang);
+                std::lock_guard<std::mutex> lock(stateMutex);
+                state = value;
             }
-            found->second = LangState::INITIALIZED;
+            stateChanged.notify_all();
         }
+
+        // Runs load unless state says it's been run already. If another thread is running it,
+        // waits for that one to finish instead
+        template <typename Load>
+        void loadOnce(StateFlag& state, Load load)
+        {
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                stateChanged.wait(lock, [&state]() { return state != LangState::INITIALIZING; });
+                if (state == LangState::INITIALIZED)
+                {
+                    return;
+                }
+                state = LangState::INITIALIZING;
+            }
+
+            try
+            {
+                load();
+            }
+            catch (...)
+            {
+                // Let the next caller try again rather than leave its waiters hanging
+                setState(state, LangState::UNINITIALIZED);
+                throw;
+            }
+            setState(state, LangState::INITIALIZED);
+        }
+
+        struct Preload
+        {
+            std::promise<void> done;
+            std::atomic<size_t> remaining{size_t(Category::COUNT)};
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+#endif
     }
 
-    void exit(void)
+    void loadCategory(pksm::Language lang, Category category)
     {
-        for (auto& lang : languages)
+        StateFlag* states = languages.find(lang)->second.categories;
+        loadOnce(states[size_t(category)], [lang, category]() {
+            initCallback callback = categoryInits[size_t(category)];
+            // A removed default stays unloaded until exit, like it would have with init
+            if (!registered(callback))
+            {
+                return;
+            }
+            // Other languages of this category may be loading at the same time, which is safe since
+            // every category's map already has each language's entry (see perLanguage)
+            callback(lang);
+        });
+
+        // Every category has copied out what it needs, so the blob would only sit on the heap. The
+        // English one goes too, since lang may have fallen back to it; holders keep theirs alive
+        if (std::all_of(states, states + size_t(Category::COUNT),
+                [](const StateFlag& state) { return state == LangState::INITIALIZED; }))
         {
-            if (lang.second != LangState::UNINITIALIZED)
+            exitTable(lang);
+            if (lang != pksm::Language::ENG)
             {
+                exitTable(pksm::Language::ENG);
+            }
+        }
+    }
+
+    void loadCustom(pksm::Language lang)
+    {
+        loadOnce(languages.find(lang)->second.custom, [lang]() {
+            for (const auto& callback : currentInitCallbacks())
+            {
+                if (!isDefault(callback))
+                {
+                    callback(lang);
+                }
+            }
+        });
+    }
+
+    void init(pksm::Language lang)
+    {
+        auto found = languages.find(lang);
+        // Should never happen, but might as well check
+        if (found == languages.end())
+        {
+            found = languages.find(pksm::Language::ENG);
+        }
+        loadCustom(found->first);
+        for (size_t i = 0; i < size_t(Category::COUNT); i++)
+        {
+            loadCategory(found->first, Category(i));
+        }
+    }
+
 #ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
-                while (lang.second != LangState::INITIALIZED)
+    std::shared_future<void> preload(pksm::Language lang)
+    {
+        auto found = languages.find(lang);
+        if (found == languages.end())
+        {
+            found = languages.find(pksm::Language::ENG);
+        }
+        lang = found->first;
+
+        auto preload                 = std::make_shared<Preload>();
+        std::shared_future<void> ret = preload->done.get_future().share();
+        for (size_t i = 0; i < size_t(Category::COUNT); i++)
+        {
+            preloadThreads.add(std::thread([lang, i, preload]() {
+                try
                 {
-                    timespec time = {0, 100000};
-                    nanosleep(&time, nullptr);
+                    loadCategory(lang, Category(i));
                 }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(preload->errorMutex);
+                    if (!preload->error)
+                    {
+                        preload->error = std::current_exception();
+                    }
+                }
+                // The last one to finish reports for all of them
+                if (--preload->remaining == 0)
+                {
+                    if (preload->error)
+                    {
+                        preload->done.set_exception(preload->error);
+                    }
+                    else
+                    {
+                        preload->done.set_value();
+                    }
+                }
+            }));
+        }
+        return ret;
+    }
 #endif
 
+    void exit(void)
+    {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        preloadThreads.joinAll();
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+#endif
+        for (auto& lang : languages)
+        {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+            stateChanged.wait(lock, [&lang]() { return !busy(lang.second); });
+#endif
+            if (used(lang.second))
+            {
                 for (const auto& callback : exitCallbacks)
                 {
                     callback(lang.first);
                 }
 
-                lang.second = LangState::UNINITIALIZED;
+                lang.second.custom = LangState::UNINITIALIZED;
+                for (auto& category : lang.second.categories)
+                {
+                    category = LangState::UNINITIALIZED;
+                }
             }
         }
     }
@@ -150,8 +400,55 @@ namespace i18n
         return "eng";
     }
 
+    StringTable::List packedList(pksm::Language lang, const std::string& name,
+        std::shared_ptr<const StringTable>& holder)
+    {
+        std::string_view file = std::string_view(name).substr(1);
+        if ((holder = table(lang)))
+        {
+            if (StringTable::List found = holder->list(file))
+            {
+                return found;
+            }
+            if ((holder = table(pksm::Language::ENG)))
+            {
+                return holder->list(file);
+            }
+        }
+        return {};
+    }
+
+    StringTable::Map packedMap(pksm::Language lang, const std::string& name,
+        std::shared_ptr<const StringTable>& holder)
+    {
+        std::string_view file = std::string_view(name).substr(1);
+        if ((holder = table(lang)))
+        {
+            if (StringTable::Map found = holder->map(file))
+            {
+                return found;
+            }
+            if ((holder = table(pksm::Language::ENG)))
+            {
+                return holder->map(file);
+            }
+        }
+        return {};
+    }
+
     void load(pksm::Language lang, const std::string& name, std::vector<std::string>& array)
     {
+        std::shared_ptr<const StringTable> holder;
+        if (StringTable::List packed = packedList(lang, name, holder))
+        {
+            array.reserve(array.size() + packed.size());
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                array.emplace_back(packed[i]);
+            }
+            return;
+        }
+
         std::string path = io::exists(_PKSMCORE_LANG_FOLDER + folder(lang) + name)
                                ? _PKSMCORE_LANG_FOLDER + folder(lang) + name
                                : _PKSMCORE_LANG_FOLDER + folder(pksm::Language::ENG) + name;
@@ -188,6 +485,9 @@ namespace i18n
 
     void addInitCallback(initCallback callback)
     {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::lock_guard<std::mutex> lock(callbackMutex);
+#endif
         auto i = std::find(initCallbacks.begin(), initCallbacks.end(), callback);
         if (i == initCallbacks.end())
         {
@@ -197,6 +497,9 @@ namespace i18n
 
     void removeInitCallback(initCallback callback)
     {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::lock_guard<std::mutex> lock(callbackMutex);
+#endif
         auto i = std::find(initCallbacks.begin(), initCallbacks.end(), callback);
         while (i != initCallbacks.end())
         {
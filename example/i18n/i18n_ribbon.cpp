@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> ribbons;
+    std::unordered_map<pksm::Language, std::vector<std::string>> ribbons =
+        perLanguage<std::vector<std::string>>();
 
     void initRibbon(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/ribbons.txt", vec);
-        ribbons.insert_or_assign(lang, std::move(vec));
+        ribbons[lang] = std::move(vec);
     }
 
-    void exitRibbon(pksm::Language lang) { ribbons.erase(lang); }
+    void exitRibbon(pksm::Language lang) { ribbons[lang] = {}; }
 
     const std::string& ribbon(pksm::Language lang, pksm::Ribbon val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ribbon);
         if (ribbons.count(lang) > 0)
         {
             if (size_t(val) < ribbons[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawRibbons(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Ribbon);
         if (ribbons.count(lang) > 0)
         {
             return ribbons[lang];
@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> speciess;
+    std::unordered_map<pksm::Language, std::vector<std::string>> speciess =
+        perLanguage<std::vector<std::string>>();
 
     void initSpecies(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/species.txt", vec);
-        speciess.insert_or_assign(lang, std::move(vec));
+        speciess[lang] = std::move(vec);
     }
 
-    void exitSpecies(pksm::Language lang) { speciess.erase(lang); }
+    void exitSpecies(pksm::Language lang) { speciess[lang] = {}; }
 
     const std::string& species(pksm::Language lang, pksm::Species val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Species);
         if (speciess.count(lang) > 0)
         {
             if (size_t(val) < speciess[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawSpecies(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Species);
         if (speciess.count(lang) > 0)
         {
             return speciess[lang];
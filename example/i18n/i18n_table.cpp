@@ -0,0 +1,237 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "i18n_table.hpp"
+#include "i18n_internal.hpp"
+#include "utils/endian.hpp"
+#include "utils/storage.hpp"
+#include <algorithm>
+#include <cstring>
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+#include <mutex>
+#endif
+
+namespace
+{
+    constexpr char MAGIC[8]      = {'P', 'K', 'S', 'M', 'S', 'T', 'R', 'S'};
+    constexpr size_t HEADER_SIZE = 0x10;
+    constexpr size_t ENTRY_SIZE  = 0x10;
+    constexpr u8 KIND_LIST       = 0;
+    constexpr u8 KIND_MAP        = 1;
+
+    u32 readU32(const u8* data) { return LittleEndian::convertTo<u32>(data); }
+}
+
+namespace i18n
+{
+    std::string_view StringTable::List::operator[](size_t i) const
+    {
+        u32 begin = readU32(offsets + 4 * i);
+        u32 end   = readU32(offsets + 4 * (i + 1));
+        return std::string_view(reinterpret_cast<const char*>(base) + begin, end - begin);
+    }
+
+    u32 StringTable::Map::key(size_t i) const { return readU32(keys + 4 * i); }
+
+    std::optional<std::string_view> StringTable::Map::find(u32 key) const
+    {
+        size_t low = 0, high = size();
+        while (low < high)
+        {
+            size_t mid = (low + high) / 2;
+            if (this->key(mid) < key)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        if (low < size() && this->key(low) == key)
+        {
+            return value(low);
+        }
+        return std::nullopt;
+    }
+
+    std::unique_ptr<StringTable> StringTable::open(const std::string& path)
+    {
+        std::unique_ptr<pksm::Storage> storage = pksm::Storage::open(path);
+        if (!storage || storage->size() < HEADER_SIZE)
+        {
+            return nullptr;
+        }
+        std::unique_ptr<StringTable> table(new StringTable(storage->map(), storage->size()));
+        if (!table->valid())
+        {
+            return nullptr;
+        }
+        return table;
+    }
+
+    bool StringTable::valid()
+    {
+        const u8* blob = data.get();
+        if (memcmp(blob, MAGIC, sizeof(MAGIC)) != 0 || readU32(blob + 0x08) != VERSION)
+        {
+            return false;
+        }
+        fileCount = readU32(blob + 0x0C);
+        if (fileCount > (length - HEADER_SIZE) / ENTRY_SIZE)
+        {
+            return false;
+        }
+
+        // Everything a lookup could touch is checked once here, so lookups don't have to
+        for (u32 i = 0; i < fileCount; i++)
+        {
+            const u8* entry = blob + HEADER_SIZE + ENTRY_SIZE * i;
+            u32 nameOffset  = readU32(entry);
+            u16 nameLength  = LittleEndian::convertTo<u16>(entry + 4);
+            u8 kind         = entry[6];
+            u64 count       = readU32(entry + 8);
+            u64 index       = readU32(entry + 12);
+            u64 indexSize   = 4 * (count + 1) + (kind == KIND_MAP ? 4 * count : 0);
+            if (u64(nameOffset) + nameLength > length || (kind != KIND_LIST && kind != KIND_MAP) ||
+                index + indexSize > length)
+            {
+                return false;
+            }
+
+            const u8* offsets = blob + index + (kind == KIND_MAP ? 4 * count : 0);
+            for (u64 j = 0; j < count; j++)
+            {
+                if (readU32(offsets + 4 * j) > readU32(offsets + 4 * (j + 1)))
+                {
+                    return false;
+                }
+            }
+            if (readU32(offsets + 4 * count) > length)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool StringTable::findFile(std::string_view name, u8 kind, u32& index, u32& count) const
+    {
+        const u8* blob = data.get();
+        auto nameOf    = [blob](u32 i) {
+            const u8* entry = blob + HEADER_SIZE + ENTRY_SIZE * i;
+            return std::string_view(reinterpret_cast<const char*>(blob) + readU32(entry),
+                LittleEndian::convertTo<u16>(entry + 4));
+        };
+
+        u32 low = 0, high = fileCount;
+        while (low < high)
+        {
+            u32 mid = (low + high) / 2;
+            if (nameOf(mid) < name)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        if (low == fileCount || nameOf(low) != name)
+        {
+            return false;
+        }
+
+        const u8* entry = blob + HEADER_SIZE + ENTRY_SIZE * low;
+        if (entry[6] != kind)
+        {
+            return false;
+        }
+        count = readU32(entry + 8);
+        index = readU32(entry + 12);
+        return true;
+    }
+
+    StringTable::List StringTable::list(std::string_view name) const
+    {
+        List ret;
+        u32 index, count;
+        if (findFile(name, KIND_LIST, index, count))
+        {
+            ret.base    = data.get();
+            ret.offsets = data.get() + index;
+            ret.count   = count;
+        }
+        return ret;
+    }
+
+    StringTable::Map StringTable::map(std::string_view name) const
+    {
+        Map ret;
+        u32 index, count;
+        if (findFile(name, KIND_MAP, index, count))
+        {
+            ret.keys            = data.get() + index;
+            ret.strings.base    = data.get();
+            ret.strings.offsets = data.get() + index + 4 * count;
+            ret.strings.count   = count;
+        }
+        return ret;
+    }
+
+    namespace
+    {
+        // An empty pointer is cached too, for languages that have no table
+        std::unordered_map<pksm::Language, std::shared_ptr<const StringTable>> tables;
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::mutex tablesMutex;
+#endif
+    }
+
+    std::shared_ptr<const StringTable> table(pksm::Language lang)
+    {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::lock_guard<std::mutex> lock(tablesMutex);
+#endif
+        auto found = tables.find(lang);
+        if (found == tables.end())
+        {
+            found = tables
+                        .emplace(lang, StringTable::open(
+                                           _PKSMCORE_LANG_FOLDER + folder(lang) + ".bin"))
+                        .first;
+        }
+        return found->second;
+    }
+
+    void exitTable(pksm::Language lang)
+    {
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+        std::lock_guard<std::mutex> lock(tablesMutex);
+#endif
+        tables.erase(lang);
+    }
+}
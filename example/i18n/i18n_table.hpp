@@ -0,0 +1,107 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef I18N_TABLE_HPP
+#define I18N_TABLE_HPP
+
+#include "utils/coretypes.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace i18n
+{
+    // One language's strings, packed into a single blob by tools/pack_strings.py so that loading
+    // them is one read and a lookup is an index instead of a parse. Little endian, all offsets from
+    // the start of the blob:
+    //
+    //   0x00  "PKSMSTRS"
+    //   0x08  u32 version
+    //   0x0C  u32 file count
+    //   0x10  16 bytes per file, sorted by name: u32 name offset, u16 name length, u8 kind (0 for a
+    //         list, 1 for a map), u8 unused, u32 string count, u32 index offset
+    //
+    // A list's index is count + 1 u32 string offsets, string i ending where string i + 1 starts. A
+    // map's index is its count keys, sorted, as u32s followed by the same offsets. Strings are
+    // UTF-8 without terminators. Files are named by their path in the language folder, like
+    // "subregions/001.txt"
+    class StringTable
+    {
+    public:
+        static constexpr u32 VERSION = 1;
+
+        class List
+        {
+        public:
+            size_t size() const { return count; }
+            std::string_view operator[](size_t i) const;
+            // False if the file isn't in the table
+            explicit operator bool() const { return offsets != nullptr; }
+
+        private:
+            friend class StringTable;
+            const u8* base    = nullptr;
+            const u8* offsets = nullptr;
+            u32 count         = 0;
+        };
+
+        class Map
+        {
+        public:
+            size_t size() const { return strings.size(); }
+            u32 key(size_t i) const;
+            std::string_view value(size_t i) const { return strings[i]; }
+            std::optional<std::string_view> find(u32 key) const;
+            explicit operator bool() const { return bool(strings); }
+
+        private:
+            friend class StringTable;
+            const u8* keys = nullptr;
+            List strings;
+        };
+
+        // nullptr if there's no valid table at path
+        static std::unique_ptr<StringTable> open(const std::string& path);
+
+        // Falsy if there's no such file in the table, or it's of the other kind
+        List list(std::string_view name) const;
+        Map map(std::string_view name) const;
+
+    private:
+        StringTable(std::shared_ptr<u8[]> data, size_t length) : data(data), length(length) {}
+
+        std::shared_ptr<u8[]> data;
+        size_t length;
+        u32 fileCount = 0;
+
+        bool valid();
+        // Index offset and count of the named file, if it's of that kind
+        bool findFile(std::string_view name, u8 kind, u32& index, u32& count) const;
+    };
+}
+
+#endif
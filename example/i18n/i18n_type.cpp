@@ -29,20 +29,21 @@
 
 namespace i18n
 {
-    std::unordered_map<pksm::Language, std::vector<std::string>> types;
+    std::unordered_map<pksm::Language, std::vector<std::string>> types =
+        perLanguage<std::vector<std::string>>();
 
     void initType(pksm::Language lang)
     {
         std::vector<std::string> vec;
         load(lang, "/types.txt", vec);
-        types.insert_or_assign(lang, std::move(vec));
+        types[lang] = std::move(vec);
     }
 
-    void exitType(pksm::Language lang) { types.erase(lang); }
+    void exitType(pksm::Language lang) { types[lang] = {}; }
 
     const std::string& type(pksm::Language lang, pksm::Type val)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Type);
         if (types.count(lang) > 0)
         {
             if (size_t(val) < types[lang].size())
@@ -55,7 +56,7 @@ namespace i18n
 
     const std::vector<std::string>& rawTypes(pksm::Language lang)
     {
-        checkInitialized(lang);
+        checkInitialized(lang, Category::Type);
         if (types.count(lang) > 0)
         {
             return types[lang];
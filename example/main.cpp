@@ -24,13 +24,20 @@
 #include <string>
 #include <fstream>
 
+#include "bank.hpp"
 #include "custom_layout_tab.hpp"
 #include "sample_installer_page.hpp"
 #include "sample_loading_page.hpp"
+#include "save_loader.hpp"
+#include "save_loading_page.hpp"
+#include "save_page.hpp"
+#include "save_prober.hpp"
+#include "species_names.hpp"
 
 #include <sav/Sav.hpp>
 #include <utils/crypto.hpp>
 #include <utils/random.hpp>
+#include <utils/storage.hpp>
 #include <pkx/PK8.hpp>
 #include <pkx/PK7.hpp>
 #include <pkx/PK6.hpp>
@@ -53,14 +60,48 @@
 std::vector<std::vector<std::string>> namelst(32);
 
 std::unique_ptr<pksm::Sav> save;
-std::unique_ptr<pksm::PKX> box1Data[32][30];
+// What the open save's file held after its last commit, so SaveWriter only rewrites what changed
+std::shared_ptr<std::vector<u8>> saveBaseline = std::make_shared<std::vector<u8>>();
 std::unique_ptr<pksm::PKX> clipboard;
+std::unique_ptr<Bank> bank;
 int clipBoxIdx;
 int clipPkmIdx;
 bool clipFromBank;
 bool clipFromInject;
+// The bank tab has views for one box only; showBankBox points them at another
+int bankBoxIdx = 0;
+std::function<void(int)> showBankBox;
 std::string filepath;
 u32 size = 0;
+// SaveLoader only ever hands over SavSWSH saves, so the cast holds for whatever is open
+pksm::PKXView<pksm::PK8> boxSlot(int box, int slot)
+{
+	return static_cast<pksm::SavSWSH*>(save.get())->pkmView(box, slot);
+}
+
+// The open save can't be written, or swapped for another, until the SaveLoader is done with it
+bool SaveBusy()
+{
+	if (SaveLoader::busy())
+	{
+		brls::Application::notify("Still loading\nthe save!");
+		return true;
+	}
+	return false;
+}
+
+// A box of the open save can only be touched once the SaveLoader has handed it over. Box views only
+// exist for boxes that have been, so this is for reaching other boxes
+bool BoxBusy(int box)
+{
+	if (!SaveLoader::boxOpen(box))
+	{
+		brls::Application::notify("Still loading\nthat box!");
+		return true;
+	}
+	return false;
+}
+
 bool CheckIsDir(std::string Path)
 {
 	struct stat statbuf;
@@ -88,75 +129,6 @@ bool CheckFileExists(std::string Path)
 	return (stat (Path.c_str(), &buffer) == 0); 
 }
 
-std::string pokeToString(pksm::Species pkmn)
-{
-	std::ifstream pokelist("romfs:/strings/eng/species.txt");
-	if (pokelist.is_open())
-	{
-		if (pkmn == pksm::Species::None)
-		{
-			pokelist.close();
-			return "(Empty Space)";
-		}
-		else
-		{
-			for (int i = 0; i < (int)pkmn; i++)
-			{
-				pokelist.ignore(256, '\n');
-			}
-			std::string pokename;
-			std::getline(pokelist, pokename, '\n');
-			pokelist.close();
-			return pokename;
-		}
-	}
-	else
-	{
-		return "FILE NOT FOUND";
-	}
-}
-
-std::string toSpriteName(std::string pokemonName)
-{
-	std::string returnVal = "romfs:/";
-	std::size_t found = pokemonName.find(".");
-	if (found != std::string::npos)
-	{
-		pokemonName.erase(pokemonName.begin() + (int)found);
-	}
-    std::size_t found2 = pokemonName.find("’");
-    if (found2 != std::string::npos)
-    {
-        pokemonName.erase(pokemonName.begin() + (int)found2, pokemonName.end() - 1);
-    }
-	std::size_t found3 = pokemonName.find("♀");
-	if (found3 != std::string::npos)
-	{
-		pokemonName.replace(pokemonName.begin() + (int)found3, pokemonName.end(), "-f");
-	}
-	std::size_t found4 = pokemonName.find("♂");
-	if (found4 != std::string::npos)
-	{
-		pokemonName.replace(pokemonName.begin() + (int)found4, pokemonName.end(), "-m");
-	}
-	std::size_t found5 = pokemonName.find(" ");
-	if (found5 != std::string::npos)
-	{
-		pokemonName.replace(pokemonName.begin() + (int)found5, pokemonName.begin() + (int)found5 + 1, "-");
-	}
-	std::size_t found6 = pokemonName.find(":");
-	if (found6 != std::string::npos)
-    {
-        pokemonName.erase(pokemonName.begin() + (int)found6);
-    }
-	std::for_each(pokemonName.begin(), pokemonName.end(), [](char & c) {
-        c = ::tolower(c);
-    });
-    pokemonName += ".jpg";
-    returnVal += pokemonName;
-    return returnVal;
-}
-
 int main(int argc, char* argv[])
 {
 	srand(time(0));
@@ -177,80 +149,105 @@ int main(int argc, char* argv[])
     brls::List* testList = new brls::List();
 
 	pksm::seedRand(time(0));
+	SpeciesNames::load(pksm::Language::ENG);
     brls::SelectListItem* layerSelectItem = new brls::SelectListItem("Select game", { "Sword", "Shield" });
 
-	if (!CheckFileExists("sdmc:/switch/Eevee.bank"))
+	brls::List* bankStorage = new brls::List();
+	try
 	{
-		std::ofstream bnkCreate("sdmc:/switch/Eevee.bank", std::ios::binary);
-		for (int i = 0; i < 10320; i++)
-		{
-			bnkCreate << '\0';
-		}
-		bnkCreate.close();
+		bank = std::make_unique<Bank>("sdmc:/switch/Eevee.bank");
+		brls::Logger::info("Bank: {} boxes, dedup ratio {:.2f}", bank->boxes(), bank->dedupRatio());
 	}
-	brls::List* bankStorage = new brls::List();
-    std::vector<brls::Label*> bankBoxes;
-	FILE* bnk = fopen("sdmc:/switch/Eevee.bank", "rb");
-	fseek(bnk, 0, SEEK_END);
-    u32 bnkSize = ftell(bnk);
-    rewind(bnk);
-    fseek(bnk, 0, SEEK_SET);
-    std::vector<std::vector<std::string>> pokelist((size_t)(bnkSize / 344 / 30));
-    std::vector<std::vector<brls::ListItem*>> pokelist2((size_t)(bnkSize / 344 / 30));
-    std::vector<std::vector<std::shared_ptr<pksm::PKX>>> pokegomz((size_t)(bnkSize / 344 / 30));
-	u8* bankData = new u8[bnkSize];
-	u8* tempPokegom = new u8[344];
-	fread(bankData, 1, bnkSize, bnk);
-	fclose(bnk);
-	int k = 0;
-	for (unsigned int i = 0; i < bnkSize / 344 / 30; i++)
+	catch (const std::exception& e)
+	{
+		brls::Application::crash(e.what());
+	}
+	// Only one bank box has views at a time, so the tab costs the same however many boxes the bank holds
+	brls::ListItem* bankBoxItem = new brls::ListItem("Bank box");
+	brls::ListItem* prevBankBox = new brls::ListItem("Previous box");
+	brls::ListItem* nextBankBox = new brls::ListItem("Next box");
+	std::vector<brls::ListItem*> bankSlots;
+	for (int j = 0; j < 30; j++)
+	{
+		bankSlots.push_back(new brls::ListItem(""));
+	}
+	showBankBox = [=](int box)
 	{
-        bankBoxes.push_back(new brls::Label(brls::LabelStyle::REGULAR, "Bank " + std::to_string(i + 1), true));
-        bankStorage->addView(bankBoxes[i]);
-		for(int j = 0; j < 30; j++)
+		bankBoxIdx = box;
+		bankBoxItem->setValue(std::to_string(box + 1) + " / " + std::to_string(bank->boxes()));
+		for (int j = 0; j < 30; j++)
 		{
-			for (int l = 0; l < 344; l++)
+			pksm::Species species = bank->species(box, j);
+			bankSlots[j]->setLabel(std::string(SpeciesNames::name(species)));
+			if (!SpeciesNames::sprite(species).empty())
 			{
-				tempPokegom[l] = bankData[k];
-				k++;
-			}	pokegomz[i].push_back(pksm::PKX::getPKM(pksm::Generation::EIGHT, tempPokegom, false, false));
-			pokelist[i].push_back(pokeToString(pokegomz[i][j]->species()));
-        
-        pokelist2[i].push_back(new brls::ListItem(pokelist[i][j]));
-        
-        if (pokelist[i][j] != "(Empty Space)" && pokelist[i][j] != "FILE NOT FOUND")
-        {
-        	pokelist2[i][j]->setThumbnail(toSpriteName(pokelist[i][j]));
-        }
-        
-        bankStorage->addView(pokelist2[i][j]);
-        
-        pokelist2[i][j]->registerAction("Copy", brls::Key::L, [=]()->bool{
-			u8* readData = new u8[344];
+				bankSlots[j]->setThumbnail(std::string(SpeciesNames::sprite(species)));
+			}
+			else
+			{
+				bankSlots[j]->setThumbnail((brls::Image*)nullptr);
+			}
+		}
+	};
+	if (bank)
+	{
+		bankBoxItem->getClickEvent()->subscribe([=](brls::View* view){
+			brls::Swkbd::openForNumber([=](int num){
+				if (num > 0 && num <= (int)bank->boxes())
+				{
+					showBankBox(num - 1);
+				}
+			}, "Bank box (1-" + std::to_string(bank->boxes()) + ")", "", 5, "", "", "");
+		});
+		prevBankBox->getClickEvent()->subscribe([=](brls::View* view){
+			if (bankBoxIdx > 0)
+			{
+				showBankBox(bankBoxIdx - 1);
+			}
+		});
+		nextBankBox->getClickEvent()->subscribe([=](brls::View* view){
+			if (bankBoxIdx + 1 < (int)bank->boxes())
+			{
+				showBankBox(bankBoxIdx + 1);
+			}
+		});
+		bankStorage->addView(bankBoxItem);
+		bankStorage->addView(prevBankBox);
+		bankStorage->addView(nextBankBox);
+		for (int j = 0; j < 30; j++)
+		{
+			bankStorage->addView(bankSlots[j]);
+        bankSlots[j]->registerAction("Copy", brls::Key::L, [=]()->bool{
+			int i = bankBoxIdx;
+			u8 readData[Bank::SLOT_SIZE];
 			clipBoxIdx = i;
 			clipPkmIdx = j;
 			clipFromBank = true;
-			for (int l = 0; l < 344; l++)
+			bank->readSlot(i, j, readData);
+			if (!bank->boxIntact(i))
 			{
-				readData[l] = bankData[i + (j * 344) + l];
+				brls::Application::notify("This bank box failed\nits checksum!");
 			}
         	clipboard = pksm::PKX::getPKM(pksm::Generation::EIGHT, readData, true, false);
         	return true;
         });
-        pokelist2[i][j]->registerAction("Paste", brls::Key::R, [=]()->bool{
+        bankSlots[j]->registerAction("Paste", brls::Key::R, [=]()->bool{
+			int i = bankBoxIdx;
         	if (!clipFromInject)
         	{
         	brls::Dialog* pasteDialog = new brls::Dialog("Do you want to\nmove or copy?");
         	pasteDialog->addButton("Copy", [=](brls::View* view){
         		pasteDialog->close();
         		clipboard->refreshChecksum();
-        		for (int l = 0; l < 344; l++)
-        		{
-        			bankData[i + (j * 344) + l] = clipboard->rawData()[l];
-        		}
+        		bank->writeSlot(i, j, clipboard->partyClone()->rawData());
+        		showBankBox(bankBoxIdx);
         	});
         	pasteDialog->addButton("Move", [=](brls::View* view){
         		pasteDialog->close();
+        		if (!clipFromBank && BoxBusy(clipBoxIdx))
+        		{
+        			return;
+        		}
         		FILE* emptyPkxFile = fopen("romfs:/Empty Space.pk8", "rb");
         		u8* emptyPkxData = new u8[344];
         		fread(emptyPkxData, 1, 344, emptyPkxFile);
@@ -260,10 +257,7 @@ int main(int argc, char* argv[])
         		emptyPkx->refreshChecksum();
         		if (clipFromBank)
         		{
-        			for (int l = 0; l < 344; l++)
-        			{
-        				bankData[clipBoxIdx + (clipPkmIdx * 344) + l] = emptyPkx->rawData()[l];
-        			}
+        			bank->writeSlot(clipBoxIdx, clipPkmIdx, emptyPkx->rawData());
         		}
         		else
         		{
@@ -271,10 +265,8 @@ int main(int argc, char* argv[])
         			save->dex(*emptyPkx);
         		}
         		clipboard->refreshChecksum();
-        		for (int l = 0; l < 344; l++)
-        		{
-        			bankData[i + (j * 344) + l] = clipboard->rawData()[l];
-        		}
+        		bank->writeSlot(i, j, clipboard->partyClone()->rawData());
+        		showBankBox(bankBoxIdx);
         	});
         	pasteDialog->setCancelable(false);
         	pasteDialog->open();
@@ -282,44 +274,45 @@ int main(int argc, char* argv[])
         	else
         	{
         		clipboard->refreshChecksum();
-        		for (int l = 0; l < 344; l++)
-        		{
-        			bankData[i + (j * 344) + l] = clipboard->rawData()[l];
-        		}
+        		bank->writeSlot(i, j, clipboard->partyClone()->rawData());
+        		showBankBox(bankBoxIdx);
         	}
         	return true;
         });
-        pokelist2[i][j]->registerAction("Dump pkx", brls::Key::Y, [=]()->bool{
+        bankSlots[j]->registerAction("Dump pkx", brls::Key::Y, [=]()->bool{
+			int i = bankBoxIdx;
     	time_t rawtime;
     	time(&rawtime);
     	std::string dumpName;
-        if (pokeToString(pokegomz[i][j]->species()) != "Type: Null")
+    	u8 slotData[Bank::SLOT_SIZE];
+    	bank->readSlot(i, j, slotData);
+        if (SpeciesNames::name(bank->species(i, j)) != "Type: Null")
         {
-        	dumpName = pokeToString(pokegomz[i][j]->species()) + "-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
+        	dumpName = std::string(SpeciesNames::name(bank->species(i, j))) + "-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
         }
         else
         {
         	dumpName = "Type Null-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
         }
         FILE* dumpFile = fopen(dumpName.c_str(), "wb");
-        fwrite(pokegomz[i][j]->partyClone()->rawData(), 1, 344, dumpFile);
+        fwrite(pksm::PKX::getPKM(pksm::Generation::EIGHT, slotData, false, false)->partyClone()->rawData(), 1, 344, dumpFile);
         fclose(dumpFile);
         return true;
         });
-        pokelist2[i][j]->registerAction("Delete", brls::Key::X, [=]()->bool{
+        bankSlots[j]->registerAction("Delete", brls::Key::X, [=]()->bool{
+			int i = bankBoxIdx;
         	FILE* emptyPkxFile = fopen("romfs:/Empty Space.pk8", "rb");
         	u8* emptyPkxData = new u8[344];
         	fread(emptyPkxData, 1, 344, emptyPkxFile);
         	fclose(emptyPkxFile);
         	std::unique_ptr<pksm::PKX> emptyPkx = pksm::PKX::getPKM(pksm::Generation::EIGHT, emptyPkxData, (size_t)344, false);
         	emptyPkx->refreshChecksum();
-        	for (int l = 0; l < 344; l++)
-        	{
-        		bankData[i + (j * 344) + l] = emptyPkx->rawData()[l];
-        	}
+        	bank->writeSlot(i, j, emptyPkx->rawData());
+        	showBankBox(bankBoxIdx);
         	return true;
         });
 		}
+		showBankBox(0);
 	}
 	
 	brls::List* batchEditTab = new brls::List();
@@ -327,11 +320,15 @@ int main(int argc, char* argv[])
 	std::vector<pksm::Move> eeveeMoves = {pksm::Move::Tackle, pksm::Move::TailWhip, pksm::Move::Growl, pksm::Move::HelpingHand, pksm::Move::Covet, pksm::Move::SandAttack, pksm::Move::QuickAttack, pksm::Move::BabyDollEyes, pksm::Move::Swift, pksm::Move::Bite, pksm::Move::Copycat, pksm::Move::BatonPass, pksm::Move::TakeDown, pksm::Move::Charm, pksm::Move::DoubleEdge, pksm::Move::LastResort, pksm::Move::PayDay, pksm::Move::Dig, pksm::Move::Rest, pksm::Move::Snore, pksm::Move::Protect, pksm::Move::Charm, pksm::Move::Attract, pksm::Move::RainDance, pksm::Move::SunnyDay, pksm::Move::Facade, pksm::Move::Swift, pksm::Move::HelpingHand, pksm::Move::WeatherBall, pksm::Move::FakeTears, pksm::Move::Round, pksm::Move::Retaliate, pksm::Move::BodySlam, pksm::Move::FocusEnergy, pksm::Move::Substitute, pksm::Move::Endure, pksm::Move::SleepTalk, pksm::Move::BatonPass, pksm::Move::IronTail, pksm::Move::ShadowBall, pksm::Move::HyperVoice, pksm::Move::StoredPower, pksm::Move::WorkUp, pksm::Move::Curse, pksm::Move::Detect, pksm::Move::DoubleKick, pksm::Move::Flail, pksm::Move::MudSlap, pksm::Move::Tickle, pksm::Move::Wish, pksm::Move::Yawn};
 	brls::ListItem* joyconhax = new brls::ListItem("Cover Eevee's \"daycare part\" with a Joy-Con");
 	joyconhax->getClickEvent()->subscribe([=](brls::View* view){
+		if (BoxBusy(location->getSelectedValue()))
+		{
+			return;
+		}
 		for (int i = 0; i < 30; i++)
 		{
-			if (save->pkm(location->getSelectedValue(), i)->species() != pksm::Species::None)
+			if (boxSlot(location->getSelectedValue(), i)->species() != pksm::Species::None)
 			{
-				std::unique_ptr<pksm::PKX> eeveePkx = save->pkm(location->getSelectedValue(), i)->partyClone();
+				std::unique_ptr<pksm::PKX> eeveePkx = boxSlot(location->getSelectedValue(), i)->partyClone();
 				eeveePkx->species(pksm::Species::Eevee);
 				eeveePkx->move(0, eeveeMoves[rand() % eeveeMoves.size()]);
 				eeveePkx->move(1, eeveeMoves[rand() % eeveeMoves.size()]);
@@ -422,89 +419,66 @@ int main(int argc, char* argv[])
     std::vector<std::vector<dirent>> saves;
     brls::ListItem* saveButton = new brls::ListItem("Save open files");
     saveButton->getClickEvent()->subscribe([=](brls::View* view){
-    		save->cryptBoxData(false);
-        	save->finishEditing();
-        	std::shared_ptr<u8[]> rawSave = save->rawData();
-        	FILE* out = fopen(filepath.c_str(), "wb");
-        	fseek(out, 0, SEEK_SET);
-        	fwrite(rawSave.get(), 1, size, out);
-        	fclose(out);
-        	FILE* bnkout = fopen("sdmc:/switch/Eevee.bank", "wb");
-        	fseek(bnkout, 0, SEEK_SET);
-        	fwrite(bankData, 1, bnkSize, bnkout);
-        	if (pokegomz[(bnkSize / 344 / 30) - 1][29]->species() != pksm::Species::None)
+    		if (SaveBusy())
+    		{
+    			return;
+    		}
+    		if (save)
+    		{
+        		brls::StagedAppletFrame* saveFrame = new brls::StagedAppletFrame();
+        		saveFrame->setTitle("Saving");
+        		saveFrame->addStage(new SavePage(saveFrame, std::make_unique<SaveWriter>(*save, filepath, saveBaseline)));
+        		brls::Application::pushView(saveFrame);
+    		}
+        	if (bank)
         	{
-        		u8* newBox = new u8[10320];
-        		for (int i = 0; i < 10320; i++)
+        		if (bank->species(bank->boxes() - 1, 29) != pksm::Species::None)
         		{
-        			newBox[i] = '\0';
+        			bank->addBox();
+        			showBankBox(bankBoxIdx);
+        		}
+        		if (!bank->save())
+        		{
+        			brls::Application::notify("Could not save\nthe bank!");
         		}
-        		fwrite(newBox, 1, 10320, bnkout);
         	}
-        	fclose(bnkout);
         });
-    for(unsigned long i = 0; i < titles.size(); i++)
-    {
-    	layerList.push_back(new brls::List());
-    }
-    for (unsigned long i = 0; i < layerList.size(); i++)
-    {
-    	layerList[i]->addView(new brls::Header(titles[i], false));
-    	saves.push_back(LoadDirs(paths[i].string()));
-    	for (unsigned long j = 0; j < saves[i].size(); j++)
-		{
-			std::string tmpstr = saves[i][j].d_name;
-			blah[i].push_back(new brls::ListItem(tmpstr));
-		}
-		for(unsigned long j = 0; j < blah[i].size(); j++)
-		{
-			layerList[i]->addView(blah[i][j]);
-		}
-    	for (unsigned long j = 0; j < blah[i].size(); j++)
+    // Decoded on the SaveLoader's worker, so it goes through the save it was given rather than boxSlot.
+    // The loader has already turned away anything that isn't a SavSWSH
+    auto decodeSaveBox = [](pksm::Sav& loading, int l) {
+    	std::vector<pksm::Species> species;
+    	for (int k = 0; k < 30; k++)
     	{
-    		blah[i][j]->getClickEvent()->subscribe([=](brls::View* view) {
-    			filepath = paths[i].string() + "/" + blah[i][j]->getLabel() + "/main";
-    			FILE* in = fopen(filepath.c_str(), "rb");
-    			std::shared_ptr<u8[]> saveData = nullptr;
-    			if (in)
-    			{
-    				fseek(in, 0, SEEK_END);
-        			size = ftell(in);
-        			rewind(in);
-    				saveData = std::shared_ptr<u8[]>(new u8[size]);
-    				fseek(in, 0, SEEK_SET);
-    				fread(saveData.get(), 1, size, in);
-        			fclose(in);
-    			}
-    			save = pksm::Sav::getSave(saveData, size);
-        		std::vector<std::vector<brls::ListItem*>> vaporeon(32);
-        		std::vector<brls::Label*> boxes;
-        		for (int l = 0; l < 32; l++)
-        		{
-        		boxes.push_back(new brls::Label(brls::LabelStyle::REGULAR, "Box " + std::to_string(l + 1), true));
-        		blahbakata->addView(boxes[l]);
-    			for (int k = 0; k < 30; k++)
+    		species.push_back(static_cast<pksm::SavSWSH&>(loading).pkmView(l, k)->species());
+    	}
+    	return species;
+    };
+    // Builds one box of the Current Save tab as the SaveLoader streams it in
+    auto addSaveBox = [=](int l, const std::vector<pksm::Species>& species) {
+    	namelst[l].clear();
+    	for (pksm::Species slotSpecies : species)
+    	{
+    		namelst[l].emplace_back(SpeciesNames::name(slotSpecies));
+    	}
+    	std::vector<brls::ListItem*> vaporeon;
+    	blahbakata->addView(new brls::Label(brls::LabelStyle::REGULAR, "Box " + std::to_string(l + 1), true));
+    	for (int k = 0; k < 30; k++)
     {
-        box1Data[l][k] = save->pkm(l, k);
-        save->pkm(l, k)->decrypt();
-        box1Data[l][k]->decrypt();
-        	namelst[l].push_back(pokeToString(box1Data[l][k]->species()));
-        	
-        vaporeon[l].push_back(new brls::ListItem(namelst[l][k]));
-        if (namelst[l][k] != "(Empty Space)" && pokelist[i][j] != "FILE NOT FOUND")
+        vaporeon.push_back(new brls::ListItem(namelst[l][k]));
+        if (!SpeciesNames::sprite(species[k]).empty())
         {
-        	vaporeon[l][k]->setThumbnail(toSpriteName(namelst[l][k]));
+        	vaporeon[k]->setThumbnail(std::string(SpeciesNames::sprite(species[k])));
         }
         
-        blahbakata->addView(vaporeon[l][k]);
-        vaporeon[l][k]->registerAction("Copy", brls::Key::L, [=]()->bool{
+        blahbakata->addView(vaporeon[k]);
+        vaporeon[k]->registerAction("Copy", brls::Key::L, [=]()->bool{
 			clipBoxIdx = l;
 			clipPkmIdx = k;
 			clipFromBank = false;
-        	clipboard = save->pkm(l, k)->partyClone();
+        	clipboard = boxSlot(l, k)->partyClone();
         	return true;
         });
-        vaporeon[l][k]->registerAction("Paste", brls::Key::R, [=]()->bool{
+        vaporeon[k]->registerAction("Paste", brls::Key::R, [=]()->bool{
         	if (!clipFromInject)
         	{
         	brls::Dialog* pasteDialog = new brls::Dialog("Do you want to\nmove or copy?");
@@ -517,6 +491,10 @@ int main(int argc, char* argv[])
         	});
         	pasteDialog->addButton("Move", [=](brls::View* view){
         		pasteDialog->close();
+        		if (!clipFromBank && BoxBusy(clipBoxIdx))
+        		{
+        			return;
+        		}
         		FILE* emptyPkxFile = fopen("romfs:/Empty Space.pk8", "rb");
         		u8* emptyPkxData = new u8[344];
         		fread(emptyPkxData, 1, 344, emptyPkxFile);
@@ -526,10 +504,8 @@ int main(int argc, char* argv[])
         		emptyPkx->refreshChecksum();
         		if (clipFromBank)
         		{
-        			for (int l = 0; l < 344; l++)
-        			{
-        				bankData[clipBoxIdx + (clipPkmIdx * 344) + l] = emptyPkx->rawData()[l];
-        			}
+        			bank->writeSlot(clipBoxIdx, clipPkmIdx, emptyPkx->rawData());
+        			showBankBox(bankBoxIdx);
         		}
         		else
         		{
@@ -553,24 +529,24 @@ int main(int argc, char* argv[])
         	}
         	return true;
         });
-        vaporeon[l][k]->registerAction("Dump pkx", brls::Key::Y, [=]()->bool{
+        vaporeon[k]->registerAction("Dump pkx", brls::Key::Y, [=]()->bool{
     	time_t rawtime;
     	time(&rawtime);
     	std::string dumpName;
-        if (pokeToString(box1Data[l][k]->species()) != "Type: Null")
+        if (SpeciesNames::name(boxSlot(l, k)->species()) != "Type: Null")
         {
-        	dumpName = pokeToString(box1Data[l][k]->species()) + "-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
+        	dumpName = std::string(SpeciesNames::name(boxSlot(l, k)->species())) + "-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
         }
         else
         {
         	dumpName = "Type Null-" + std::to_string(localtime(&rawtime)->tm_year + 1900) + "-" + std::to_string(localtime(&rawtime)->tm_mon + 1) + "-" + std::to_string(localtime(&rawtime)->tm_mday) + "-" + std::to_string(localtime(&rawtime)->tm_hour) + "-" + std::to_string(localtime(&rawtime)->tm_min) + "-" + std::to_string(localtime(&rawtime)->tm_sec) + ".pk8";
         }
         FILE* dumpFile = fopen(dumpName.c_str(), "wb");
-        fwrite(save->pkm(l, k)->partyClone()->rawData(), 1, 344, dumpFile);
+        fwrite(boxSlot(l, k)->rawData(), 1, 344, dumpFile);
         fclose(dumpFile);
         return true;
         });
-        vaporeon[l][k]->registerAction("Delete", brls::Key::X, [=]()->bool{
+        vaporeon[k]->registerAction("Delete", brls::Key::X, [=]()->bool{
         	FILE* emptyPkxFile = fopen("romfs:/Empty Space.pk8", "rb");
         	u8* emptyPkxData = new u8[344];
         	fread(emptyPkxData, 1, 344, emptyPkxFile);
@@ -583,17 +559,17 @@ int main(int argc, char* argv[])
         	
         	return true;
         });
-        if (pokeToString(save->pkm(l, k)->species()) != "(Empty Space)")
+        if (namelst[l][k] != "(Empty Space)")
         {
-        	vaporeon[l][k]->getClickEvent()->subscribe([=](brls::View* view) {
+        	vaporeon[k]->getClickEvent()->subscribe([=](brls::View* view) {
         		brls::TabFrame* popupTabFrame = new brls::TabFrame();
         		brls::List* basicTabList = new brls::List();
-        		clipboard = save->pkm(l, k)->partyClone();
+        		clipboard = boxSlot(l, k)->partyClone();
 				clipBoxIdx = l;
 				clipPkmIdx = k;
 				clipFromBank = false;
         		brls::ListItem* isShiny = new brls::ListItem("Shiny");
-        		isShiny->setChecked(save->pkm(l, k)->shiny());
+        		isShiny->setChecked(boxSlot(l, k)->shiny());
         		isShiny->registerAction("Toggle off", brls::Key::L, [=]()->bool{
         			clipboard->shiny(false);
         			isShiny->setChecked(clipboard->shiny());
@@ -667,11 +643,71 @@ int main(int argc, char* argv[])
         	});
         }
     }
+    };
+    for(unsigned long i = 0; i < titles.size(); i++)
+    {
+    	layerList.push_back(new brls::List());
     }
+    for (unsigned long i = 0; i < layerList.size(); i++)
+    {
+    	layerList[i]->addView(new brls::Header(titles[i], false));
+    	saves.push_back(LoadDirs(paths[i].string()));
+    	for (unsigned long j = 0; j < saves[i].size(); j++)
+		{
+			std::string tmpstr = saves[i][j].d_name;
+			blah[i].push_back(new brls::ListItem(tmpstr));
+		}
+		for(unsigned long j = 0; j < blah[i].size(); j++)
+		{
+			layerList[i]->addView(blah[i][j]);
+		}
+    	for (unsigned long j = 0; j < blah[i].size(); j++)
+    	{
+    		blah[i][j]->getClickEvent()->subscribe([=](brls::View* view) {
+    			if (SaveLoader::busy())
+    			{
+    				brls::Application::notify("Still loading\nthe last save!");
+    				return;
+    			}
+    			std::string path = paths[i].string() + "/" + blah[i][j]->getLabel() + "/main";
+    			if (!SaveWriter::recover(path))
+    			{
+    				brls::Application::notify("The last save to this file\nwas cut short!");
+    			}
+    			// The old save's boxes, path and baseline only go once the new save is parsed, so a load
+    			// that fails leaves the old save open and "Save open files" writing it back where it came
+    			// from
+    			SaveLoader* loader = new SaveLoader(path, decodeSaveBox, [path, blahbakata](std::unique_ptr<pksm::Sav> loaded) {
+    				blahbakata->clear();
+    				for (auto& names : namelst)
+    				{
+    					names.clear();
+    				}
+    				save = std::move(loaded);
+    				size = save->getLength();
+    				filepath = path;
+    				saveBaseline = std::make_shared<std::vector<u8>>();
+    			}, addSaveBox);
+    			brls::StagedAppletFrame* loadFrame = new brls::StagedAppletFrame();
+    			loadFrame->setTitle("Loading save");
+    			loadFrame->addStage(new SaveLoadingPage(loadFrame, loader->status()));
+    			brls::Application::pushView(loadFrame);
+    			loader->start();
     		});
     	}
     	testLayers->addLayer(layerList[i]);
     }
+    std::vector<std::string> probePaths;
+    std::vector<brls::ListItem*> probeItems;
+    for (unsigned long i = 0; i < blah.size(); i++)
+    {
+    	for (unsigned long j = 0; j < blah[i].size(); j++)
+    	{
+    		probePaths.push_back(paths[i].string() + "/" + blah[i][j]->getLabel() + "/main");
+    		probeItems.push_back(blah[i][j]);
+    	}
+    }
+    (new SaveProber(probePaths, probeItems))->start();
 
     layerSelectItem->getValueSelectedEvent()->subscribe([=](size_t selection) {
         testLayers->changeLayer(selection);
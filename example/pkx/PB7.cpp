@@ -32,44 +32,34 @@
 
 namespace pksm
 {
-    void PB7::encrypt(void)
+    void PB7::encrypt(void) { encryptSlot(data, isParty()); }
+
+    void PB7::decrypt(void) { decryptSlot(data, isParty()); }
+
+    bool PB7::isEncrypted() const { return slotEncrypted(data); }
+
+    bool PB7::slotEncrypted(const u8* dt)
     {
-        if (!isEncrypted())
-        {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            refreshChecksum();
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(
-                data + ENCRYPTION_START, pksm::crypto::pkm::InvertedBlockPositions[sv]);
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-        }
+        return LittleEndian::convertTo<u16>(dt + 0xC8) != 0 &&
+               LittleEndian::convertTo<u16>(dt + 0x58) != 0;
     }
 
-    void PB7::decrypt(void)
+    void PB7::encryptSlot(u8* dt, bool party)
     {
-        if (isEncrypted())
+        if (!slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(data + ENCRYPTION_START, sv);
+            pksm::crypto::pkm::encryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
         }
     }
 
-    bool PB7::isEncrypted() const
+    void PB7::decryptSlot(u8* dt, bool party)
     {
-        return LittleEndian::convertTo<u16>(data + 0xC8) != 0 &&
-               LittleEndian::convertTo<u16>(data + 0x58) != 0;
+        if (slotEncrypted(dt))
+        {
+            pksm::crypto::pkm::decryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
+        }
     }
 
     PB7::PB7(PrivateConstructor, u8* dt, bool party, bool direct)
@@ -35,8 +35,8 @@ namespace pksm
     class PK4 : public PKX
     {
     private:
-        static constexpr size_t BLOCK_LENGTH     = 32;
-        static constexpr size_t ENCRYPTION_START = 8;
+        static constexpr size_t BLOCK_LENGTH = 32;
+        static bool slotEncrypted(const u8* dt);
         int eggYear(void) const override;
         void eggYear(int v) override;
         int eggMonth(void) const override;
@@ -76,6 +76,9 @@ namespace pksm
         void decrypt(void) override;
         void encrypt(void) override;
         bool isEncrypted(void) const override;
+        // decrypt()/encrypt() on raw stored data, for batch box crypting without PKX objects
+        static void decryptSlot(u8* dt, bool party);
+        static void encryptSlot(u8* dt, bool party);
         bool isParty(void) const override { return getLength() == PARTY_LENGTH; }
 
         u32 encryptionConstant(void) const override;
@@ -299,40 +299,30 @@ namespace
 
 namespace pksm
 {
-    void PK5::encrypt(void)
+    void PK5::encrypt(void) { encryptSlot(data, isParty()); }
+
+    void PK5::decrypt(void) { decryptSlot(data, isParty()); }
+
+    bool PK5::isEncrypted() const { return slotEncrypted(data); }
+
+    bool PK5::slotEncrypted(const u8* dt) { return LittleEndian::convertTo<u32>(dt + 0x64) != 0; }
+
+    void PK5::encryptSlot(u8* dt, bool party)
     {
-        if (!isEncrypted())
+        if (!slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            refreshChecksum();
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(
-                data + ENCRYPTION_START, pksm::crypto::pkm::InvertedBlockPositions[sv]);
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, checksum());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(data + BOX_LENGTH, PID());
-            }
+            pksm::crypto::pkm::encryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, true>(dt, party);
         }
     }
 
-    void PK5::decrypt(void)
+    void PK5::decryptSlot(u8* dt, bool party)
     {
-        if (isEncrypted())
+        if (slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, checksum());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(data + BOX_LENGTH, PID());
-            }
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(data + ENCRYPTION_START, sv);
+            pksm::crypto::pkm::decryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, true>(dt, party);
         }
     }
 
-    bool PK5::isEncrypted() const { return LittleEndian::convertTo<u32>(data + 0x64) != 0; }
-
     PK5::PK5(PrivateConstructor, u8* dt, bool party, bool direct)
         : PKX(dt, party ? PARTY_LENGTH : BOX_LENGTH, direct)
     {
@@ -182,44 +182,34 @@ namespace pksm
     //     }
     // }
 
-    void PK6::encrypt(void)
+    void PK6::encrypt(void) { encryptSlot(data, isParty()); }
+
+    void PK6::decrypt(void) { decryptSlot(data, isParty()); }
+
+    bool PK6::isEncrypted() const { return slotEncrypted(data); }
+
+    bool PK6::slotEncrypted(const u8* dt)
     {
-        if (!isEncrypted())
-        {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            refreshChecksum();
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(
-                data + ENCRYPTION_START, pksm::crypto::pkm::InvertedBlockPositions[sv]);
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-        }
+        return LittleEndian::convertTo<u16>(dt + 0xC8) != 0 &&
+               LittleEndian::convertTo<u16>(dt + 0x58) != 0;
     }
 
-    void PK6::decrypt(void)
+    void PK6::encryptSlot(u8* dt, bool party)
     {
-        if (isEncrypted())
+        if (!slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(data + ENCRYPTION_START, sv);
+            pksm::crypto::pkm::encryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
         }
     }
 
-    bool PK6::isEncrypted() const
+    void PK6::decryptSlot(u8* dt, bool party)
     {
-        return LittleEndian::convertTo<u16>(data + 0xC8) != 0 &&
-               LittleEndian::convertTo<u16>(data + 0x58) != 0;
+        if (slotEncrypted(dt))
+        {
+            pksm::crypto::pkm::decryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
+        }
     }
 
     PK6::PK6(PrivateConstructor, u8* dt, bool party, bool direct)
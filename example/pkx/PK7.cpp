@@ -154,44 +154,34 @@ namespace
 
 namespace pksm
 {
-    void PK7::encrypt(void)
+    void PK7::encrypt(void) { encryptSlot(data, isParty()); }
+
+    void PK7::decrypt(void) { decryptSlot(data, isParty()); }
+
+    bool PK7::isEncrypted() const { return slotEncrypted(data); }
+
+    bool PK7::slotEncrypted(const u8* dt)
     {
-        if (!isEncrypted())
-        {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            refreshChecksum();
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(
-                data + ENCRYPTION_START, pksm::crypto::pkm::InvertedBlockPositions[sv]);
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-        }
+        return LittleEndian::convertTo<u16>(dt + 0xC8) != 0 &&
+               LittleEndian::convertTo<u16>(dt + 0x58) != 0;
     }
 
-    void PK7::decrypt(void)
+    void PK7::encryptSlot(u8* dt, bool party)
     {
-        if (isEncrypted())
+        if (!slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(data + ENCRYPTION_START, sv);
+            pksm::crypto::pkm::encryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
         }
     }
 
-    bool PK7::isEncrypted() const
+    void PK7::decryptSlot(u8* dt, bool party)
     {
-        return LittleEndian::convertTo<u16>(data + 0xC8) != 0 &&
-               LittleEndian::convertTo<u16>(data + 0x58) != 0;
+        if (slotEncrypted(dt))
+        {
+            pksm::crypto::pkm::decryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
+        }
     }
 
     PK7::PK7(PrivateConstructor, u8* dt, bool party, bool direct)
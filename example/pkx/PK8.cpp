@@ -243,44 +243,51 @@ namespace
 
 namespace pksm
 {
-    void PK8::encrypt(void)
+    void PK8::encrypt(void) { encryptSlot(data, isParty()); }
+
+    void PK8::decrypt(void) { decryptSlot(data, isParty()); }
+
+    bool PK8::isEncrypted() const { return slotEncrypted(data); }
+
+    bool PK8::slotEncrypted(const u8* dt)
     {
-        if (!isEncrypted())
+        return LittleEndian::convertTo<u16>(dt + 0x70) != 0 &&
+               LittleEndian::convertTo<u16>(dt + 0xC0) != 0;
+    }
+
+    void PK8::encryptSlot(u8* dt, bool party)
+    {
+        if (!slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            refreshChecksum();
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(
-                data + ENCRYPTION_START, pksm::crypto::pkm::InvertedBlockPositions[sv]);
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
+            pksm::crypto::pkm::encryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
         }
     }
 
-    void PK8::decrypt(void)
+    void PK8::decryptSlot(u8* dt, bool party)
     {
-        if (isEncrypted())
+        if (slotEncrypted(dt))
         {
-            u8 sv = (encryptionConstant() >> 13) & 31;
-            pksm::crypto::pkm::crypt<BOX_LENGTH - ENCRYPTION_START>(
-                data + ENCRYPTION_START, encryptionConstant());
-            if (isParty())
-            {
-                pksm::crypto::pkm::crypt<PARTY_LENGTH - BOX_LENGTH>(
-                    data + BOX_LENGTH, encryptionConstant());
-            }
-            pksm::crypto::pkm::blockShuffle<BLOCK_LENGTH>(data + ENCRYPTION_START, sv);
+            pksm::crypto::pkm::decryptSlot<BLOCK_LENGTH, BOX_LENGTH, PARTY_LENGTH, false>(
+                dt, party);
         }
     }
 
-    bool PK8::isEncrypted() const
+    Species PK8::storedSpecies(const u8* dt)
     {
-        return LittleEndian::convertTo<u16>(data + 0x70) != 0 &&
-               LittleEndian::convertTo<u16>(data + 0xC0) != 0;
+        if (!slotEncrypted(dt))
+        {
+            return Species{LittleEndian::convertTo<u16>(dt + 0x08)};
+        }
+
+        // The species leads block A, so only the stored blocks up to and including it are needed
+        u32 ec       = LittleEndian::convertTo<u32>(dt);
+        u8 position  = pksm::crypto::pkm::BlockPositions[((ec >> 13) & 31) * 4];
+        size_t count = BLOCK_LENGTH * (position + 1);
+        u8 blocks[BLOCK_LENGTH * 4];
+        std::copy(dt + 8, dt + 8 + count, blocks);
+        pksm::crypto::pkm::crypt(blocks, ec, count);
+        return Species{LittleEndian::convertTo<u16>(blocks + BLOCK_LENGTH * position)};
     }
 
     PK8::PK8(PrivateConstructor, u8* dt, bool party, bool direct)
@@ -59,8 +59,14 @@ namespace pksm
     class PK8;
     class PB7;
 
+    template <typename Pkm>
+    class PKXView;
+
     class PKX : public IPKFilterable
     {
+        template <typename Pkm>
+        friend class PKXView;
+
     private:
         bool directAccess;
         virtual int eggYear(void) const  = 0;
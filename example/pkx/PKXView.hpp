@@ -0,0 +1,63 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+
+#ifndef PKXVIEW_HPP
+#define PKXVIEW_HPP
+
+#include "pkx/PKX.hpp"
+#include <type_traits>
+
+namespace pksm
+{
+    // A Pokemon that reads and writes the bytes it was handed in place, without copying them and
+    // without any heap allocation. Meant for slots in a save's box data, which must outlive the
+    // view. Like any PKX, constructing one decrypts the data if it is encrypted.
+    template <typename Pkm>
+    class PKXView
+    {
+        static_assert(std::is_base_of_v<PKX, Pkm>);
+
+    public:
+        PKXView(u8* data, bool party = false)
+            : pkm(PKX::PrivateConstructor{}, data, party, true)
+        {
+        }
+        // Copying a PKX copies its data, which would defeat the point
+        PKXView(const PKXView&) = delete;
+        PKXView& operator=(const PKXView&) = delete;
+
+        Pkm* operator->() { return &pkm; }
+        const Pkm* operator->() const { return &pkm; }
+        Pkm& operator*() { return pkm; }
+        const Pkm& operator*() const { return pkm; }
+
+    private:
+        Pkm pkm;
+    };
+}
+
+#endif
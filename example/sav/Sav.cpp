@@ -49,6 +49,110 @@
 #include "sav/SavXY.hpp"
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include <algorithm>
+#ifdef __SWITCH__
+#include <switch.h>
+#else
+#include <thread>
+#endif
+
+namespace
+{
+    // Below this a thread costs more than the slots it would crypt
+    constexpr int MIN_SLOTS_PER_THREAD = 60;
+
+    struct SlotRange
+    {
+        const std::function<void(int, int)>* func;
+        int begin;
+        int end;
+    };
+
+#ifdef __SWITCH__
+    // Applications get cores 0 to 2; pthreads would all land on the caller's core
+    constexpr int APPLICATION_CORES = 3;
+
+    void slotRangeEntry(void* arg)
+    {
+        SlotRange* range = static_cast<SlotRange*>(arg);
+        (*range->func)(range->begin, range->end);
+    }
+
+    int availableCores() { return APPLICATION_CORES; }
+#else
+    int availableCores() { return std::max(1u, std::thread::hardware_concurrency()); }
+#endif
+
+    // Splits [first, first + count) into one contiguous range per thread and calls func with each
+    void runRanges(int first, int count, int threads, const std::function<void(int, int)>& func)
+    {
+        if (threads <= 1)
+        {
+            if (count > 0)
+            {
+                func(first, first + count);
+            }
+            return;
+        }
+
+        std::vector<SlotRange> ranges(threads);
+        for (int i = 0; i < threads; i++)
+        {
+            ranges[i] = {&func, first + count * i / threads, first + count * (i + 1) / threads};
+        }
+
+        // The calling thread takes the first range itself
+#ifdef __SWITCH__
+        std::vector<Thread> workers(threads - 1);
+        std::vector<bool> started(threads - 1, false);
+        s32 priority = 0x2C;
+        svcGetThreadPriority(&priority, CUR_THREAD_HANDLE);
+        int core = svcGetCurrentProcessorNumber();
+        for (int i = 1; i < threads; i++)
+        {
+            core = (core + 1) % APPLICATION_CORES;
+            if (R_SUCCEEDED(threadCreate(&workers[i - 1], slotRangeEntry, &ranges[i], nullptr,
+                    0x10000, priority, core)))
+            {
+                if (R_SUCCEEDED(threadStart(&workers[i - 1])))
+                {
+                    started[i - 1] = true;
+                }
+                else
+                {
+                    threadClose(&workers[i - 1]);
+                }
+            }
+        }
+        func(ranges[0].begin, ranges[0].end);
+        for (int i = 1; i < threads; i++)
+        {
+            if (started[i - 1])
+            {
+                threadWaitForExit(&workers[i - 1]);
+                threadClose(&workers[i - 1]);
+            }
+            else
+            {
+                // Couldn't get a thread for this one
+                func(ranges[i].begin, ranges[i].end);
+            }
+        }
+#else
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (int i = 1; i < threads; i++)
+        {
+            workers.emplace_back(func, ranges[i].begin, ranges[i].end);
+        }
+        func(ranges[0].begin, ranges[0].end);
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+#endif
+    }
+}
 
 namespace pksm
 {
@@ -71,20 +175,71 @@ namespace pksm
             case 0xB8800:
             case 0x100000:
                 return std::make_unique<SavLGPE>(dt, length);
-            case 0x1716B3: // base
-            case 0x17195E: // base->wañel
-            case 0x180B19: // base->wañel->armor
-            case 0x180AD0: // base->armor
-            case 0x18764A: // base->crown
-            case 0x187668: // base->armor->crown
-            case 0x187693: // base->wañel->crown
-            case 0x1876B1: // base->wañel->armor->crown
-                return std::make_unique<SavSWSH>(dt, length);
             default:
+                if (SavSWSH::isSaveLength(length))
+                {
+                    return std::make_unique<SavSWSH>(dt, length);
+                }
                 return std::unique_ptr<Sav>(nullptr);
         }
     }
 
+    std::unique_ptr<Sav> Sav::getSave(Storage& storage)
+    {
+        return getSave(storage.map(), storage.size());
+    }
+
+    std::optional<Sav::Summary> Sav::probe(Storage& storage)
+    {
+        if (SavSWSH::isSaveLength(storage.size()))
+        {
+            return SavSWSH::probe(storage);
+        }
+
+        std::unique_ptr<Sav> save = getSave(storage);
+        if (!save)
+        {
+            return std::nullopt;
+        }
+        Summary summary;
+        summary.otName        = save->otName();
+        summary.displayTID    = save->displayTID();
+        summary.playedHours   = save->playedHours();
+        summary.playedMinutes = save->playedMinutes();
+        summary.playedSeconds = save->playedSeconds();
+        summary.badges        = save->badges();
+        summary.boxedPokemon  = 0;
+        summary.boxSlots      = save->maxBoxes() * 30;
+        for (int box = 0; box < save->maxBoxes(); box++)
+        {
+            for (int slot = 0; slot < 30; slot++)
+            {
+                if (save->pkm(box, slot)->species() != Species::None)
+                {
+                    summary.boxedPokemon++;
+                }
+            }
+        }
+        return summary;
+    }
+
+    std::vector<std::optional<Sav::Summary>> Sav::probe(const std::vector<std::string>& paths)
+    {
+        std::vector<std::optional<Summary>> summaries(paths.size());
+        // Each probe is a handful of reads, so every save gets a thread up to the core count
+        runRanges(0, paths.size(), std::min<int>(availableCores(), paths.size()),
+            [&](int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    if (std::unique_ptr<Storage> storage = Storage::open(paths[i]))
+                    {
+                        summaries[i] = probe(*storage);
+                    }
+                }
+            });
+        return summaries;
+    }
+
     std::unique_ptr<Sav> Sav::checkGBAType(std::shared_ptr<u8[]> dt)
     {
         switch (Sav3::getVersion(dt))
@@ -213,6 +368,13 @@ namespace pksm
         return nullptr;
     }
 
+    void Sav::cryptBoxData(bool crypted) { cryptBoxSlots(0, maxSlot(), crypted); }
+
+    void Sav::forEachSlotRange(int first, int count, const std::function<void(int, int)>& func)
+    {
+        runRanges(first, count, std::min(availableCores(), count / MIN_SLOTS_PER_THREAD), func);
+    }
+
     void Sav::fixParty()
     {
         // Poor man's bubble sort-like thing
@@ -39,10 +39,14 @@
 #include "utils/DateTime.hpp"
 #include "utils/VersionTables.hpp"
 #include "utils/coretypes.h"
+#include "utils/storage.hpp"
 #include "wcx/WCX.hpp"
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -78,6 +82,28 @@ namespace pksm
         static std::unique_ptr<Sav> checkDSType(std::shared_ptr<u8[]> dt);
         static bool validSequence(std::shared_ptr<u8[]> dt, size_t offset);
 
+        // Splits [first, first + count) into contiguous ranges, one per available core, and calls
+        // func with each [begin, end). Returns once every range is done
+        static void forEachSlotRange(
+            int first, int count, const std::function<void(int, int)>& func);
+
+        // cryptBoxSlots for generations whose Pkm provides the static decryptSlot/encryptSlot pair
+        template <typename Pkm>
+        void cryptSlots(u8* boxData, int firstSlot, int count, bool crypted, bool party)
+        {
+            forEachSlotRange(firstSlot, count, [=](int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    u8* slot = boxData + boxOffset(i / 30, i % 30);
+                    Pkm::decryptSlot(slot, party);
+                    if (!crypted)
+                    {
+                        Pkm::encryptSlot(slot, party);
+                    }
+                }
+            });
+        }
+
     public:
         enum class Pouch
         {
@@ -122,6 +148,26 @@ namespace pksm
         std::unique_ptr<PKX> transfer(const PKX& pk);
         static bool isValidDSSave(std::shared_ptr<u8[]> dt);
         static std::unique_ptr<Sav> getSave(std::shared_ptr<u8[]> dt, size_t length);
+        // Nothing is copied where the storage maps the file
+        static std::unique_ptr<Sav> getSave(Storage& storage);
+
+        // Enough about a save to tell it apart from others without opening it
+        struct Summary
+        {
+            std::string otName;
+            u32 displayTID;
+            u16 playedHours;
+            u8 playedMinutes;
+            u8 playedSeconds;
+            u8 badges;
+            int boxedPokemon;
+            int boxSlots;
+        };
+        // Reads only what the summary needs where the format allows it (SwSh), and loads the save
+        // otherwise. nullopt if it isn't a save
+        static std::optional<Summary> probe(Storage& storage);
+        // Probes every path, spread over the available cores. nullopt for any that can't be read
+        static std::vector<std::optional<Summary>> probe(const std::vector<std::string>& paths);
 
         virtual u16 TID(void) const                    = 0;
         virtual void TID(u16 v)                        = 0;
@@ -172,19 +218,23 @@ namespace pksm
             const Date& date = Date::today()) const   = 0; // Look into bank boolean parameter
         virtual std::unique_ptr<PKX> emptyPkm() const = 0;
 
-        virtual void dex(const PKX& pk)                            = 0;
-        virtual int dexSeen(void) const                            = 0;
-        virtual int dexCaught(void) const                          = 0;
-        virtual int currentGiftAmount(void) const                  = 0;
-        virtual std::unique_ptr<WCX> mysteryGift(int pos) const    = 0;
-        virtual void mysteryGift(const WCX& wc, int& pos)          = 0;
-        virtual void cryptBoxData(bool crypted)                    = 0;
-        virtual std::string boxName(u8 box) const                  = 0;
-        virtual void boxName(u8 box, const std::string_view& name) = 0;
-        virtual u8 boxWallpaper(u8 box) const                      = 0;
-        virtual void boxWallpaper(u8 box, const u8 v)              = 0;
-        virtual u8 partyCount(void) const                          = 0;
-        virtual void partyCount(u8 count)                          = 0;
+        virtual void dex(const PKX& pk)                         = 0;
+        virtual int dexSeen(void) const                         = 0;
+        virtual int dexCaught(void) const                       = 0;
+        virtual int currentGiftAmount(void) const               = 0;
+        virtual std::unique_ptr<WCX> mysteryGift(int pos) const = 0;
+        virtual void mysteryGift(const WCX& wc, int& pos)       = 0;
+        virtual void cryptBoxData(bool crypted);
+        // Decrypts (crypted) or encrypts (!crypted) slots [firstSlot, firstSlot + count) in place,
+        // where a slot is box * 30 + slot, without building PKX objects. cryptBoxData covers every
+        // slot
+        virtual void cryptBoxSlots(int firstSlot, int count, bool crypted) = 0;
+        virtual std::string boxName(u8 box) const                          = 0;
+        virtual void boxName(u8 box, const std::string_view& name)         = 0;
+        virtual u8 boxWallpaper(u8 box) const                              = 0;
+        virtual void boxWallpaper(u8 box, const u8 v)                      = 0;
+        virtual u8 partyCount(void) const                                  = 0;
+        virtual void partyCount(u8 count)                                  = 0;
         virtual void fixParty(void); // Has to be overridden by SavLGPE because it works stupidly
 
         virtual int maxSlot(void) const { return maxBoxes() * 30; }
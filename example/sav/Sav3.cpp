@@ -507,33 +507,34 @@ namespace pksm
     // Unused
     std::unique_ptr<WCX> Sav3::mysteryGift(int) const { return nullptr; }
 
-    void Sav3::cryptBoxData(bool crypted)
+    void Sav3::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
+        // Gen 3 slots can straddle sector boundaries and carry no encryption flag, so this stays
+        // single-threaded and goes through PK3
+        for (int i = firstSlot; i < firstSlot + count; i++)
         {
-            for (u8 slot = 0; slot < 30; slot++)
+            u8 box     = i / 30;
+            u8 slot    = i % 30;
+            u32 offset = boxOffset(box, slot);
+            bool split = (offset % 0x1000) + PK3::BOX_LENGTH > 0xF80;
+            // If it's split, it needs to get fully copied out and re-set in
+            // Otherwise, use the direct-modification constructor
+            std::unique_ptr<PKX> pk3;
+            if (split)
+            {
+                pk3 = pkm(box, slot);
+            }
+            else
+            {
+                pk3 = PKX::getPKM<Generation::THREE>(&data[offset], false, true);
+            }
+            if (!crypted)
+            {
+                pk3->encrypt();
+            }
+            if (split)
             {
-                u32 offset = boxOffset(box, slot);
-                bool split = (offset % 0x1000) + PK3::BOX_LENGTH > 0xF80;
-                // If it's split, it needs to get fully copied out and re-set in
-                // Otherwise, use the direct-modification constructor
-                std::unique_ptr<PKX> pk3;
-                if (split)
-                {
-                    pk3 = pkm(box, slot);
-                }
-                else
-                {
-                    pk3 = PKX::getPKM<Generation::THREE>(&data[offset], false, true);
-                }
-                if (!crypted)
-                {
-                    pk3->encrypt();
-                }
-                if (split)
-                {
-                    pkm(*pk3, box, slot, false);
-                }
+                pkm(*pk3, box, slot, false);
             }
         }
     }
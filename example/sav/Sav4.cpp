@@ -272,20 +272,9 @@ namespace pksm
         }
     }
 
-    void Sav4::cryptBoxData(bool crypted)
+    void Sav4::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                std::unique_ptr<PKX> pk4 =
-                    PKX::getPKM<Generation::FOUR>(&data[boxOffset(box, slot)], false, true);
-                if (!crypted)
-                {
-                    pk4->encrypt();
-                }
-            }
-        }
+        cryptSlots<PK4>(data.get(), firstSlot, count, crypted, false);
     }
 
     bool Sav4::giftsMenuActivated(void) const { return (data[gbo + 72] & 1) == 1; }
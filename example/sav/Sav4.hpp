@@ -124,7 +124,7 @@ namespace pksm
         void giftsMenuActivated(bool v);
         void mysteryGift(const WCX& wc, int& pos) override;
         std::unique_ptr<WCX> mysteryGift(int pos) const override;
-        void cryptBoxData(bool crypted) override;
+        void cryptBoxSlots(int firstSlot, int count, bool crypted) override;
         std::string boxName(u8 box) const override;
         void boxName(u8 box, const std::string_view& name) override;
         u8 boxWallpaper(u8 box) const override;
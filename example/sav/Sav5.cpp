@@ -147,20 +147,9 @@ namespace pksm
         }
     }
 
-    void Sav5::cryptBoxData(bool crypted)
+    void Sav5::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                std::unique_ptr<PKX> pk5 =
-                    PKX::getPKM<Generation::FIVE>(&data[boxOffset(box, slot)], false, true);
-                if (!crypted)
-                {
-                    pk5->encrypt();
-                }
-            }
-        }
+        cryptSlots<PK5>(data.get(), firstSlot, count, crypted, false);
     }
 
     int Sav5::dexFormIndex(int species, int formct) const
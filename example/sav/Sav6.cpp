@@ -235,20 +235,9 @@ namespace pksm
         }
     }
 
-    void Sav6::cryptBoxData(bool crypted)
+    void Sav6::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                std::unique_ptr<PKX> pk6 =
-                    PKX::getPKM<Generation::SIX>(&data[boxOffset(box, slot)], false, true);
-                if (!crypted)
-                {
-                    pk6->encrypt();
-                }
-            }
-        }
+        cryptSlots<PK6>(data.get(), firstSlot, count, crypted, false);
     }
 
     int Sav6::dexFormIndex(int species, int formct) const
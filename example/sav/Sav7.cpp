@@ -181,20 +181,9 @@ namespace pksm
         }
     }
 
-    void Sav7::cryptBoxData(bool crypted)
+    void Sav7::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                std::unique_ptr<PKX> pk7 =
-                    PKX::getPKM<Generation::SEVEN>(&data[boxOffset(box, slot)], false, true);
-                if (!crypted)
-                {
-                    pk7->encrypt();
-                }
-            }
-        }
+        cryptSlots<PK7>(data.get(), firstSlot, count, crypted, false);
     }
 
     void Sav7::setDexFlags(int index, int gender, int shiny, int baseSpecies)
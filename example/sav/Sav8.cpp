@@ -28,26 +28,101 @@
 #include "pkx/PK8.hpp"
 #include <algorithm>
 
+namespace
+{
+    // Blocks that the SwSh accessors go through all the time. Each one gets its own slot in a
+    // perfect hash, found at compile time, so looking them up doesn't need a search
+    constexpr std::array<u32, 14> hotBlockKeys = {
+        0x0d66012c, // Box
+        0x112d5141, // WondercardData
+        0x2985fe5d, // Party
+        0x4716c404, // PokeDex
+        0x3F936BA9, // ArmorDex
+        0x3C9366F0, // CrownDex
+        0x1177c2c4, // Items
+        0x19722c89, // BoxLayout
+        0x1b882b09, // Misc
+        0x874da6fa, // TrainerCard
+        0x8cbbfd90, // PlayTime
+        0xf25c070e, // Status
+        0x017C3CBB, // Current box
+        0x2EB1B190, // Box wallpapers
+    };
+    constexpr size_t HOT_BLOCK_BITS  = 5;
+    constexpr size_t HOT_BLOCK_SLOTS = 1 << HOT_BLOCK_BITS;
+    constexpr u16 NO_BLOCK           = 0xFFFF;
+
+    constexpr u32 hotBlockSlot(u32 key, u32 multiplier)
+    {
+        return u32(key * multiplier) >> (32 - HOT_BLOCK_BITS);
+    }
+
+    constexpr u32 findHotBlockMultiplier()
+    {
+        for (u32 multiplier = 0x9E3779B1;; multiplier += 2)
+        {
+            bool used[HOT_BLOCK_SLOTS] = {};
+            bool collision             = false;
+            for (u32 key : hotBlockKeys)
+            {
+                u32 slot = hotBlockSlot(key, multiplier);
+                if (used[slot])
+                {
+                    collision = true;
+                    break;
+                }
+                used[slot] = true;
+            }
+            if (!collision)
+            {
+                return multiplier;
+            }
+        }
+    }
+
+    constexpr u32 hotBlockMultiplier = findHotBlockMultiplier();
+
+    constexpr u32 hotBlockSlot(u32 key) { return hotBlockSlot(key, hotBlockMultiplier); }
+}
+
 namespace pksm
 {
     Sav8::Sav8(std::shared_ptr<u8[]> dt, size_t length) : Sav(dt, length)
     {
         pksm::crypto::swsh::applyXor(dt, length);
-        blocks = pksm::crypto::swsh::getBlockList(dt, length);
+        blocks = pksm::crypto::swsh::getBlockList(dt.get(), length);
+
+        static_assert(std::tuple_size_v<decltype(hotBlocks)> == HOT_BLOCK_SLOTS);
+        hotBlocks.fill(NO_BLOCK);
+        for (u32 key : hotBlockKeys)
+        {
+            auto found = std::lower_bound(blocks.begin(), blocks.end(), key,
+                [](const pksm::crypto::swsh::SCBlock& block, u32 key) {
+                    return block.key() < key;
+                });
+            if (found != blocks.end() && found->key() == key && found - blocks.begin() < NO_BLOCK)
+            {
+                hotBlocks[hotBlockSlot(key)] = found - blocks.begin();
+            }
+        }
     }
 
-    std::shared_ptr<pksm::crypto::swsh::SCBlock> Sav8::getBlock(u32 key) const
+    pksm::crypto::swsh::SCBlock* Sav8::getBlock(u32 key) const
     {
+        u16 index = hotBlocks[hotBlockSlot(key)];
+        if (index != NO_BLOCK && blocks[index].key() == key)
+        {
+            return &blocks[index];
+        }
+
         // binary search
         auto found = std::lower_bound(blocks.begin(), blocks.end(), key,
-            [](const std::shared_ptr<pksm::crypto::swsh::SCBlock>& block, u32 key) {
-                return block->key() < key;
-            });
-        if ((*found)->key() != key)
+            [](const pksm::crypto::swsh::SCBlock& block, u32 key) { return block.key() < key; });
+        if (found == blocks.end() || found->key() != key)
         {
             return nullptr;
         }
-        return *found;
+        return &*found;
     }
 
     std::unique_ptr<PKX> Sav8::emptyPkm() const { return PKX::getPKM<Generation::EIGHT>(nullptr); }
@@ -89,13 +164,25 @@ namespace pksm
     {
         if (!encrypted)
         {
+            // Blocks that were never decrypted are still in their stored form
             for (auto& block : blocks)
             {
-                block->encrypt();
+                if (block.decrypted())
+                {
+                    block.encrypt();
+                    modified = true;
+                }
             }
 
-            pksm::crypto::swsh::applyXor(data, length);
-            pksm::crypto::swsh::sign(data, length);
+            if (modified)
+            {
+                pksm::crypto::swsh::applyXorAndSign(data, length);
+                modified = false;
+            }
+            else
+            {
+                pksm::crypto::swsh::applyXor(data, length);
+            }
         }
         encrypted = true;
     }
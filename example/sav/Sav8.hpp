@@ -35,17 +35,27 @@ namespace pksm
 {
     class Sav8 : public Sav
     {
+    private:
+        // Index into blocks for each slot of the perfect hash over frequently used keys (see
+        // Sav8.cpp), or 0xFFFF if the slot is empty
+        std::array<u16, 32> hotBlocks;
+
     protected:
-        std::vector<std::shared_ptr<pksm::crypto::swsh::SCBlock>> blocks;
+        // Lazily decrypted, so reading a block through a const save still changes its state
+        mutable std::vector<pksm::crypto::swsh::SCBlock> blocks;
 
         int Items, BoxLayout, Misc, TrainerCard, PlayTime, Status;
 
         bool encrypted = false;
+        // Whether any block has been decrypted since the save was loaded or last signed. If not,
+        // the stored hash is still valid and signing can be skipped
+        bool modified = false;
 
     public:
         Sav8(std::shared_ptr<u8[]> dt, size_t length);
 
-        std::shared_ptr<pksm::crypto::swsh::SCBlock> getBlock(u32 key) const;
+        // Returns nullptr if there is no block with that key
+        pksm::crypto::swsh::SCBlock* getBlock(u32 key) const;
 
         void finishEditing(void) override;
         void beginEditing(void) override;
@@ -561,24 +561,9 @@ namespace pksm
         return ret;
     }
 
-    void SavLGPE::cryptBoxData(bool crypted)
+    void SavLGPE::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                if (box * 30 + slot > 1000)
-                {
-                    return;
-                }
-                std::unique_ptr<PKX> pb7 =
-                    PKX::getPKM<Generation::LGPE>(&data[boxOffset(box, slot)], true, true);
-                if (!crypted)
-                {
-                    pb7->encrypt();
-                }
-            }
-        }
+        cryptSlots<PB7>(data.get(), firstSlot, count, crypted, true);
     }
 
     void SavLGPE::mysteryGift(const WCX& wc, int&)
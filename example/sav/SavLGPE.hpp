@@ -126,7 +126,7 @@ namespace pksm
         void mysteryGift(const WCX& wc, int& pos) override;
         std::unique_ptr<WCX> mysteryGift(
             int pos) const override; // Always returns null: Data not stored
-        void cryptBoxData(bool crypted) override;
+        void cryptBoxSlots(int firstSlot, int count, bool crypted) override;
         std::string boxName(u8) const override
         {
             return "";
@@ -202,6 +202,76 @@ namespace pksm
         Status         = 0xf25c070e;
     }
 
+    bool SavSWSH::isSaveLength(size_t length)
+    {
+        switch (length)
+        {
+            case 0x1716B3: // base
+            case 0x17195E: // base->wañel
+            case 0x180B19: // base->wañel->armor
+            case 0x180AD0: // base->armor
+            case 0x18764A: // base->crown
+            case 0x187668: // base->armor->crown
+            case 0x187693: // base->wañel->crown
+            case 0x1876B1: // base->wañel->armor->crown
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::optional<Sav::Summary> SavSWSH::probe(Storage& storage)
+    {
+        // The same blocks and offsets the accessors below use
+        constexpr u32 BoxKey      = 0x0d66012c;
+        constexpr u32 MiscKey     = 0x1b882b09;
+        constexpr u32 PlayTimeKey = 0x8cbbfd90;
+        constexpr u32 StatusKey   = 0xf25c070e;
+
+        try
+        {
+            pksm::crypto::swsh::StoredBlocks blocks(storage);
+
+            // TID at 0xA0, SID at 0xA2, OT name at 0xB0
+            u8 status[0x10 + 13 * 2];
+            u8 playTime[4];
+            u8 badges;
+            std::vector<u8> box(PK8::PARTY_LENGTH * 30 * 32);
+            if (!blocks.read(StatusKey, 0xA0, status, sizeof(status)) ||
+                !blocks.read(PlayTimeKey, 0, playTime, sizeof(playTime)) ||
+                !blocks.read(MiscKey, 0x11C, &badges, 1) ||
+                !blocks.read(BoxKey, 0, box.data(), box.size()))
+            {
+                return std::nullopt;
+            }
+
+            Summary summary;
+            summary.otName     = StringUtils::getString(status, 0x10, 13);
+            summary.displayTID = u32(LittleEndian::convertTo<u16>(status + 2) << 16 |
+                                     LittleEndian::convertTo<u16>(status)) %
+                                 1000000;
+            summary.playedHours   = LittleEndian::convertTo<u16>(playTime);
+            summary.playedMinutes = playTime[2];
+            summary.playedSeconds = playTime[3];
+            summary.badges        = badges;
+            summary.boxedPokemon  = 0;
+            summary.boxSlots      = 30 * 32;
+            for (size_t offset = 0; offset < box.size(); offset += PK8::PARTY_LENGTH)
+            {
+                if (PK8::storedSpecies(box.data() + offset) != Species::None)
+                {
+                    summary.boxedPokemon++;
+                }
+            }
+            return summary;
+        }
+        catch (const std::exception&)
+        {
+            // A header that doesn't decode; not a save after all
+            return std::nullopt;
+        }
+    }
+
     u16 SavSWSH::TID(void) const
     {
         return LittleEndian::convertTo<u16>(getBlock(Status)->decryptedData() + 0xA0);
@@ -517,45 +587,57 @@ namespace pksm
         return PKX::getPKM<Generation::EIGHT>(getBlock(Box)->decryptedData() + offset, true);
     }
 
+    PKXView<PK8> SavSWSH::pkmView(u8 box, u8 slot) const
+    {
+        return PKXView<PK8>(getBlock(Box)->decryptedData() + boxOffset(box, slot), true);
+    }
+
     void SavSWSH::pkm(const PKX& pk, u8 box, u8 slot, bool applyTrade)
     {
         if (pk.generation() == Generation::EIGHT)
         {
-            auto pk8 = pk.partyClone();
+            // Written straight into the slot, which then gets the party treatment in place
+            u8* slotData = getBlock(Box)->decryptedData() + boxOffset(box, slot);
+            if (pk.rawData() != slotData)
+            {
+                std::copy(pk.rawData(), pk.rawData() + pk.getLength(), slotData);
+            }
+
+            PKXView<PK8> pk8(slotData, true);
+            if (!pk.isParty())
+            {
+                std::fill(slotData + PK8::BOX_LENGTH, slotData + PK8::PARTY_LENGTH, 0);
+                pk8->updatePartyData();
+            }
             if (applyTrade)
             {
                 trade(*pk8);
             }
-
-            std::copy(pk8->rawData(), pk8->rawData() + pk8->getLength(),
-                getBlock(Box)->decryptedData() + boxOffset(box, slot));
         }
     }
     void SavSWSH::pkm(const PKX& pk, u8 slot)
     {
         if (pk.generation() == Generation::EIGHT)
         {
-            auto pk8 = pk.partyClone();
+            u8* slotData = getBlock(Party)->decryptedData() + partyOffset(slot);
+            if (pk.rawData() != slotData)
+            {
+                std::copy(pk.rawData(), pk.rawData() + pk.getLength(), slotData);
+            }
+
+            PKXView<PK8> pk8(slotData, true);
+            if (!pk.isParty())
+            {
+                std::fill(slotData + PK8::BOX_LENGTH, slotData + PK8::PARTY_LENGTH, 0);
+                pk8->updatePartyData();
+            }
             pk8->encrypt();
-            std::copy(pk8->rawData(), pk8->rawData() + pk8->getLength(),
-                getBlock(Party)->decryptedData() + partyOffset(slot));
         }
     }
 
-    void SavSWSH::cryptBoxData(bool crypted)
+    void SavSWSH::cryptBoxSlots(int firstSlot, int count, bool crypted)
     {
-        for (u8 box = 0; box < maxBoxes(); box++)
-        {
-            for (u8 slot = 0; slot < 30; slot++)
-            {
-                std::unique_ptr<PKX> pk8 = PKX::getPKM<Generation::EIGHT>(
-                    getBlock(Box)->decryptedData() + boxOffset(box, slot), true, true);
-                if (!crypted)
-                {
-                    pk8->encrypt();
-                }
-            }
-        }
+        cryptSlots<PK8>(getBlock(Box)->decryptedData(), firstSlot, count, crypted, true);
     }
 
     void SavSWSH::mysteryGift(const WCX& wc, int&)
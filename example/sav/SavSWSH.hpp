@@ -27,6 +27,8 @@
 #ifndef SAVSWSH_HPP
 #define SAVSWSH_HPP
 
+#include "pkx/PK8.hpp"
+#include "pkx/PKXView.hpp"
 #include "sav/Sav8.hpp"
 
 namespace pksm
@@ -41,6 +43,12 @@ namespace pksm
     public:
         SavSWSH(std::shared_ptr<u8[]> dt, size_t length);
 
+        // Whether a file this long can be a SwSh save; each update added blocks
+        static bool isSaveLength(size_t length);
+        // Decodes only the Status, PlayTime and Misc blocks and the species of each box slot,
+        // straight from the stored file. nullopt if the blocks can't be found
+        static std::optional<Summary> probe(Storage& storage);
+
         u16 TID(void) const override;
         void TID(u16 v) override;
         u16 SID(void) const override;
@@ -98,6 +106,9 @@ namespace pksm
 
         std::unique_ptr<PKX> pkm(u8 slot) const override;
         std::unique_ptr<PKX> pkm(u8 box, u8 slot) const override;
+        // Same as pkm(box, slot), but reads and writes the box data in place without allocating.
+        // Only valid while the box data is decrypted
+        PKXView<PK8> pkmView(u8 box, u8 slot) const;
 
         // NOTICE: this sets a pkx into the savefile, not a ekx
         // that's because PKSM works with decrypted boxes and
@@ -105,7 +116,7 @@ namespace pksm
         void pkm(const PKX& pk, u8 box, u8 slot, bool applyTrade) override;
         void pkm(const PKX& pk, u8 slot) override;
 
-        void cryptBoxData(bool crypted) override;
+        void cryptBoxSlots(int firstSlot, int count, bool crypted) override;
 
         void dex(const PKX& pk) override;
         int dexSeen(void) const override;
@@ -0,0 +1,155 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "save_loader.hpp"
+
+#include <sav/SavSWSH.hpp>
+#include <utils/storage.hpp>
+
+static std::atomic<bool> loading{false};
+// Only touched on the UI thread: whether the running loader's save is the open one yet, and how many
+// of its boxes have been handed over
+static bool saveOpened = false;
+static int boxesOpened = 0;
+
+SaveLoader::SaveLoader(const std::string& path, DecodeBox decodeBox, SaveReady saveReady, BoxReady boxReady)
+    : brls::RepeatingTask(0)
+    , path(path)
+    , decodeBox(std::move(decodeBox))
+    , saveReady(std::move(saveReady))
+    , boxReady(std::move(boxReady))
+{
+}
+
+SaveLoader::~SaveLoader()
+{
+    this->cancelled = true;
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+bool SaveLoader::busy()
+{
+    return loading;
+}
+
+bool SaveLoader::boxOpen(int box)
+{
+    return !loading || !saveOpened || box < boxesOpened;
+}
+
+void SaveLoader::onStart()
+{
+    loading      = true;
+    saveOpened   = false;
+    boxesOpened  = 0;
+    this->worker = std::thread(&SaveLoader::load, this);
+}
+
+void SaveLoader::load()
+{
+    std::unique_ptr<pksm::Storage> storage = pksm::Storage::open(this->path);
+    std::unique_ptr<pksm::Sav> save        = storage ? pksm::Sav::getSave(*storage) : nullptr;
+    storage.reset();
+
+    // Boxes are read and written as PK8 slots of a SavSWSH, so other games are turned away here
+    if (save && !dynamic_cast<pksm::SavSWSH*>(save.get()))
+    {
+        this->progress->unsupported = true;
+        save.reset();
+    }
+
+    if (!save)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->finished = true;
+        return;
+    }
+
+    // The first box is decoded before the save goes over, so whatever every box shares is set up
+    // (the SwSh Box block is decrypted) before the UI can touch the save. After that the worker only
+    // touches boxes the UI hasn't been given yet; boxOpen keeps the UI off those
+    int boxCount   = save->maxBoxes();
+    pksm::Sav& sav = *save;
+    {
+        std::vector<pksm::Species> species = this->decodeBox(sav, 0);
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->boxCount = boxCount;
+        this->loaded   = std::move(save);
+        this->decoded.emplace_back(0, std::move(species));
+    }
+
+    for (int box = 1; box < boxCount && !this->cancelled; box++)
+    {
+        std::vector<pksm::Species> species = this->decodeBox(sav, box);
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->decoded.emplace_back(box, std::move(species));
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->finished = true;
+}
+
+void SaveLoader::run(retro_time_t currentTime)
+{
+    brls::RepeatingTask::run(currentTime);
+
+    std::unique_ptr<pksm::Sav> save;
+    std::pair<int, std::vector<pksm::Species>> box(-1, {});
+    bool drained;
+    int boxCount;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        save = std::move(this->loaded);
+        if (!this->decoded.empty())
+        {
+            box = std::move(this->decoded.front());
+            this->decoded.pop_front();
+        }
+        drained  = this->finished && this->decoded.empty();
+        boxCount = this->boxCount;
+    }
+
+    if (save)
+    {
+        this->saveHandedOver = true;
+        saveOpened           = true;
+        this->saveReady(std::move(save));
+    }
+
+    if (box.first >= 0)
+    {
+        this->boxReady(box.first, box.second);
+        this->boxesShown++;
+        boxesOpened = this->boxesShown;
+        this->progress->value       = LoadProgress::MAX * this->boxesShown / boxCount;
+        this->progress->interactive = true;
+    }
+
+    if (drained)
+    {
+        if (!this->saveHandedOver)
+            this->progress->failed = true;
+        this->progress->value       = LoadProgress::MAX;
+        this->progress->interactive = true;
+        loading                     = false;
+        this->stop();
+    }
+}
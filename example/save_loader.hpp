@@ -0,0 +1,100 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <borealis.hpp>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sav/Sav.hpp>
+
+// Shared between a SaveLoader and whatever shows its progress, which may outlive it
+struct LoadProgress
+{
+    static constexpr int MAX = 1000;
+
+    std::atomic<int> value{0};
+    // Set once the first box is on screen
+    std::atomic<bool> interactive{false};
+    std::atomic<bool> failed{false};
+    // Set along with failed when the file is a save, but not a Sword/Shield one
+    std::atomic<bool> unsupported{false};
+};
+
+// Opens a save on a worker thread, decoding its boxes one at a time, and hands the results to the UI
+// thread as a RepeatingTask: the save once its first box is decoded, then one decoded box per frame
+// so the views can be built without stalling a frame. The worker never touches views, and the
+// callbacks only ever run on the UI thread. The TaskManager owns the loader once started
+class SaveLoader : public brls::RepeatingTask
+{
+  public:
+    // Runs on the worker, with the save that's still being loaded
+    typedef std::function<std::vector<pksm::Species>(pksm::Sav&, int)> DecodeBox;
+    typedef std::function<void(std::unique_ptr<pksm::Sav>)> SaveReady;
+    typedef std::function<void(int, const std::vector<pksm::Species>&)> BoxReady;
+
+    SaveLoader(const std::string& path, DecodeBox decodeBox, SaveReady saveReady, BoxReady boxReady);
+    // Waits for the worker
+    ~SaveLoader();
+
+    SaveLoader(const SaveLoader&) = delete;
+    SaveLoader& operator=(const SaveLoader&) = delete;
+
+    std::shared_ptr<LoadProgress> status() const { return this->progress; }
+
+    void run(retro_time_t currentTime) override;
+    void onStart() override;
+
+    // Whether a loader is still handing boxes over; the save mustn't be replaced or written until then
+    static bool busy();
+    // Whether the open save's box can be read and written. The worker is still decoding the boxes a
+    // loader hasn't handed over yet, so those have to wait
+    static bool boxOpen(int box);
+
+  private:
+    std::string path;
+    DecodeBox decodeBox;
+    SaveReady saveReady;
+    BoxReady boxReady;
+    std::shared_ptr<LoadProgress> progress = std::make_shared<LoadProgress>();
+
+    std::mutex mutex;
+    // Guarded by mutex
+    std::unique_ptr<pksm::Sav> loaded;
+    std::deque<std::pair<int, std::vector<pksm::Species>>> decoded;
+    int boxCount  = 0;
+    bool finished = false;
+
+    // Only touched on the UI thread
+    bool saveHandedOver = false;
+    int boxesShown      = 0;
+
+    std::atomic<bool> cancelled{false};
+    std::thread worker;
+
+    void load();
+};
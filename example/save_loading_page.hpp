@@ -0,0 +1,47 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <borealis.hpp>
+#include <memory>
+
+#include "save_loader.hpp"
+
+// Shows a SaveLoader's progress as a stage of a StagedAppletFrame and closes the frame as soon as
+// the first box can be used; the rest keep coming in behind it
+class SaveLoadingPage : public brls::View
+{
+  private:
+    brls::StagedAppletFrame* frame;
+    brls::ProgressDisplay* progressDisp;
+    brls::Label* label;
+    std::shared_ptr<LoadProgress> status;
+    bool closing = false;
+
+  public:
+    SaveLoadingPage(brls::StagedAppletFrame* frame, std::shared_ptr<LoadProgress> status);
+    ~SaveLoadingPage();
+
+    void draw(NVGcontext* vg, int x, int y, unsigned width, unsigned height, brls::Style* style, brls::FrameContext* ctx) override;
+    void layout(NVGcontext* vg, brls::Style* style, brls::FontStash* stash) override;
+
+    void willAppear(bool resetState = false) override;
+    void willDisappear(bool resetState = false) override;
+};
@@ -0,0 +1,69 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "save_prober.hpp"
+
+#include <stdio.h>
+
+SaveProber::SaveProber(std::vector<std::string> paths, std::vector<brls::ListItem*> items)
+    : brls::RepeatingTask(100)
+    , paths(std::move(paths))
+    , items(std::move(items))
+{
+}
+
+SaveProber::~SaveProber()
+{
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+void SaveProber::onStart()
+{
+    this->worker = std::thread([this]() {
+        this->summaries = pksm::Sav::probe(this->paths);
+        this->finished  = true;
+    });
+}
+
+void SaveProber::run(retro_time_t currentTime)
+{
+    brls::RepeatingTask::run(currentTime);
+
+    if (!this->finished)
+        return;
+
+    for (size_t i = 0; i < this->items.size(); i++)
+    {
+        const std::optional<pksm::Sav::Summary>& summary = this->summaries[i];
+        if (!summary)
+        {
+            this->items[i]->setValue("Unreadable", true);
+            continue;
+        }
+
+        char value[96];
+        snprintf(value, sizeof(value), "%s  %06u  %u:%02u  %u badges  %d/%d", summary->otName.c_str(),
+            summary->displayTID, summary->playedHours, summary->playedMinutes, summary->badges,
+            summary->boxedPokemon, summary->boxSlots);
+        this->items[i]->setValue(value, true);
+    }
+    this->stop();
+}
@@ -0,0 +1,55 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <borealis.hpp>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sav/Sav.hpp>
+
+// Probes the saves listed in the Save Selector on a worker thread, with Sav::probe, and once they're
+// all in shows each summary as its item's value. The TaskManager owns the prober once started
+class SaveProber : public brls::RepeatingTask
+{
+  public:
+    // items[i] is the one for paths[i]
+    SaveProber(std::vector<std::string> paths, std::vector<brls::ListItem*> items);
+    // Waits for the worker
+    ~SaveProber();
+
+    SaveProber(const SaveProber&) = delete;
+    SaveProber& operator=(const SaveProber&) = delete;
+
+    void run(retro_time_t currentTime) override;
+    void onStart() override;
+
+  private:
+    std::vector<std::string> paths;
+    std::vector<brls::ListItem*> items;
+    // Only read once finished is set
+    std::vector<std::optional<pksm::Sav::Summary>> summaries;
+    std::atomic<bool> finished{false};
+    std::thread worker;
+};
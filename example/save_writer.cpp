@@ -0,0 +1,273 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "save_writer.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <utils/crypto.hpp>
+#include <utils/endian.hpp>
+#include <utils/io.hpp>
+
+namespace
+{
+    constexpr size_t WRITE_CHUNK = 0x40000;
+    // u32 offset, u32 length, u16 checksum of the bytes that follow
+    constexpr size_t UNDO_HEADER_SIZE = 10;
+    // Where each step ends, out of SaveWriter::PROGRESS_MAX
+    constexpr int SIGNED   = 400;
+    constexpr int RESTORED = 450;
+    constexpr int WRITTEN  = 950;
+
+    bool flushToDisk(FILE* file)
+    {
+        return fflush(file) == 0 && fsync(fileno(file)) == 0;
+    }
+
+    bool writeUndo(FILE* undo, size_t offset, const u8* data, size_t length)
+    {
+        u8 header[UNDO_HEADER_SIZE];
+        LittleEndian::convertFrom<u32>(header, offset);
+        LittleEndian::convertFrom<u32>(header + 4, length);
+        LittleEndian::convertFrom<u16>(header + 8, pksm::crypto::ccitt16(data, length));
+        return fwrite(header, 1, UNDO_HEADER_SIZE, undo) == UNDO_HEADER_SIZE &&
+               fwrite(data, 1, length, undo) == length;
+    }
+}
+
+SaveWriter::SaveWriter(pksm::Sav& save, const std::string& path, std::shared_ptr<std::vector<u8>> baseline)
+    : save(save), path(path), baseline(baseline), worker(&SaveWriter::run, this)
+{
+}
+
+SaveWriter::~SaveWriter()
+{
+    if (this->worker.joinable())
+        this->worker.join();
+}
+
+int SaveWriter::progress() const
+{
+    return this->progressValue;
+}
+
+bool SaveWriter::done() const
+{
+    return this->finished;
+}
+
+bool SaveWriter::succeeded() const
+{
+    return this->ok;
+}
+
+void SaveWriter::run()
+{
+    this->save.cryptBoxData(false);
+    this->save.finishEditing();
+    this->progressValue = SIGNED;
+
+    std::shared_ptr<u8[]> data = this->save.rawData();
+    std::vector<u8> snapshot(data.get(), data.get() + this->save.getLength());
+    this->save.beginEditing();
+    this->progressValue = RESTORED;
+
+    switch (this->writeChanged(snapshot))
+    {
+        case Patch::Done:
+            this->ok = true;
+            break;
+        case Patch::NotWorthIt:
+            this->ok = this->writeFull(snapshot);
+            break;
+        case Patch::Failed:
+            this->ok = false;
+            break;
+    }
+    if (this->ok)
+        *this->baseline = std::move(snapshot);
+    else
+        this->baseline->clear();
+    this->progressValue = PROGRESS_MAX;
+    this->finished      = true;
+}
+
+bool SaveWriter::recover(const std::string& path)
+{
+#ifdef __SWITCH__
+    // A full write stopped between moving the old save aside and putting the new one in place
+    std::string oldPath = path + ".old";
+    if (!io::exists(path) && io::exists(oldPath))
+        rename(oldPath.c_str(), path.c_str());
+#endif
+
+    std::string undoPath = path + ".undo";
+    FILE* undo           = fopen(undoPath.c_str(), "rb");
+    if (!undo)
+        return true;
+    FILE* save    = fopen(path.c_str(), "r+b");
+    bool restored = save != nullptr;
+    u8 header[UNDO_HEADER_SIZE];
+    std::vector<u8> bytes;
+    while (restored && fread(header, 1, UNDO_HEADER_SIZE, undo) == UNDO_HEADER_SIZE)
+    {
+        u32 offset = LittleEndian::convertTo<u32>(header);
+        u32 length = LittleEndian::convertTo<u32>(header + 4);
+        bytes.resize(std::min<u32>(length, 0x1000000));
+        // Patching only starts once the whole undo file is on disk, so a torn record means the save
+        // was never touched
+        if (bytes.size() != length || fread(bytes.data(), 1, length, undo) != length ||
+            pksm::crypto::ccitt16(bytes.data(), length) != LittleEndian::convertTo<u16>(header + 8))
+            break;
+        restored = fseek(save, offset, SEEK_SET) == 0 && fwrite(bytes.data(), 1, length, save) == length;
+    }
+    fclose(undo);
+    if (save)
+    {
+        restored = flushToDisk(save) && restored;
+        fclose(save);
+    }
+    if (restored)
+        remove(undoPath.c_str());
+    return restored;
+}
+
+SaveWriter::Patch SaveWriter::writeChanged(const std::vector<u8>& image)
+{
+    std::vector<u8>& baseline = *this->baseline;
+    if (baseline.size() != image.size())
+    {
+        baseline.clear();
+        std::unique_ptr<pksm::Storage> onDisk = pksm::Storage::open(this->path);
+        if (onDisk && onDisk->size() == image.size())
+        {
+            pksm::Span<const u8> read = onDisk->read(0, image.size());
+            if (read.size() == image.size())
+                baseline.assign(read.begin(), read.end());
+        }
+        if (baseline.empty())
+            return Patch::NotWorthIt;
+    }
+
+    // Runs of changed pages, as [begin, end) byte offsets
+    std::vector<std::pair<size_t, size_t>> runs;
+    size_t changed = 0;
+    for (size_t offset = 0; offset < image.size(); offset += PAGE_SIZE)
+    {
+        size_t end = std::min(offset + PAGE_SIZE, image.size());
+        if (memcmp(image.data() + offset, baseline.data() + offset, end - offset) == 0)
+            continue;
+        if (!runs.empty() && runs.back().second == offset)
+            runs.back().second = end;
+        else
+            runs.emplace_back(offset, end);
+        changed += end - offset;
+    }
+    if (changed == 0)
+        return Patch::Done;
+    if (changed > image.size() / 2)
+        return Patch::NotWorthIt;
+
+    std::string undoPath = this->path + ".undo";
+    FILE* undo           = fopen(undoPath.c_str(), "wb");
+    if (!undo)
+        return Patch::NotWorthIt;
+    bool saved = true;
+    for (const auto& [begin, end] : runs)
+        saved = saved && writeUndo(undo, begin, baseline.data() + begin, end - begin);
+    saved = flushToDisk(undo) && saved;
+    fclose(undo);
+    if (!saved)
+    {
+        remove(undoPath.c_str());
+        return Patch::NotWorthIt;
+    }
+
+    FILE* out    = fopen(this->path.c_str(), "r+b");
+    bool patched = out != nullptr;
+    size_t done  = 0;
+    for (const auto& [begin, end] : runs)
+    {
+        patched = patched && fseek(out, begin, SEEK_SET) == 0 &&
+                  fwrite(image.data() + begin, 1, end - begin, out) == end - begin;
+        done += end - begin;
+        this->progressValue = RESTORED + int((WRITTEN - RESTORED) * done / changed);
+    }
+    if (out)
+    {
+        patched = flushToDisk(out) && patched;
+        fclose(out);
+    }
+
+    if (patched)
+    {
+        remove(undoPath.c_str());
+        return Patch::Done;
+    }
+    // Put the old pages back so the full write starts from a whole file
+    return recover(this->path) ? Patch::NotWorthIt : Patch::Failed;
+}
+
+bool SaveWriter::writeFull(const std::vector<u8>& image)
+{
+    std::string tempPath = this->path + ".tmp";
+    FILE* out            = fopen(tempPath.c_str(), "wb");
+    if (!out)
+        return false;
+
+    size_t length = image.size();
+    bool written  = true;
+    for (size_t offset = 0; written && offset < length; offset += WRITE_CHUNK)
+    {
+        size_t count        = std::min(WRITE_CHUNK, length - offset);
+        written             = fwrite(image.data() + offset, 1, count, out) == count;
+        this->progressValue = RESTORED + int((WRITTEN - RESTORED) * (offset + count) / length);
+    }
+    written = flushToDisk(out) && written;
+    fclose(out);
+    if (!written)
+    {
+        remove(tempPath.c_str());
+        return false;
+    }
+
+#ifdef __SWITCH__
+    // The SD card won't rename over an existing file, so the old save steps aside first and is only
+    // removed once the new one is in place
+    std::string oldPath = this->path + ".old";
+    remove(oldPath.c_str());
+    if (rename(this->path.c_str(), oldPath.c_str()) != 0)
+        return false;
+    if (rename(tempPath.c_str(), this->path.c_str()) != 0)
+    {
+        rename(oldPath.c_str(), this->path.c_str());
+        return false;
+    }
+    remove(oldPath.c_str());
+    return true;
+#else
+    // The save may still be mapped from the old file; renaming over it leaves that mapping alone
+    return rename(tempPath.c_str(), this->path.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,83 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sav/Sav.hpp>
+
+// Commits a save on a worker thread so the UI keeps drawing. The worker finishes editing (box
+// encryption, block encryption and signing), snapshots the result and hands the save back ready for
+// editing. The save must not be touched until done() says so
+//
+// The snapshot is compared with baseline, what the file held after the last commit (read from the
+// file when empty), and only the 4 KiB pages that changed are rewritten in place. Their old contents
+// go to path.undo and are fsynced first, so a commit cut short can be rolled back by recover(). When
+// more than half the file changed, or there's nothing to compare with, the whole snapshot is written
+// to path.tmp, fsynced and renamed over path instead
+class SaveWriter
+{
+  public:
+    static constexpr int PROGRESS_MAX = 1000;
+    static constexpr size_t PAGE_SIZE = 0x1000;
+
+    SaveWriter(pksm::Sav& save, const std::string& path, std::shared_ptr<std::vector<u8>> baseline);
+    // Waits for the worker
+    ~SaveWriter();
+
+    SaveWriter(const SaveWriter&) = delete;
+    SaveWriter& operator=(const SaveWriter&) = delete;
+
+    // Out of PROGRESS_MAX
+    int progress() const;
+    bool done() const;
+    // Only meaningful once done
+    bool succeeded() const;
+
+    // Rolls back a commit to path that was cut short, before the save is opened again. False if one
+    // was and it couldn't be undone
+    static bool recover(const std::string& path);
+
+  private:
+    enum class Patch
+    {
+        Done,
+        // Nothing written; a full write should be used
+        NotWorthIt,
+        // Part of the file may be patched and couldn't be rolled back
+        Failed
+    };
+
+    pksm::Sav& save;
+    std::string path;
+    std::shared_ptr<std::vector<u8>> baseline;
+    std::atomic<int> progressValue{0};
+    std::atomic<bool> finished{false};
+    bool ok = false;
+    std::thread worker;
+
+    void run();
+    Patch writeChanged(const std::vector<u8>& image);
+    bool writeFull(const std::vector<u8>& image);
+};
@@ -0,0 +1,116 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "species_names.hpp"
+
+#include <algorithm>
+#include <ctype.h>
+#include <i18n/i18n_table.hpp>
+#include <memory>
+#include <string>
+#include <utils/i18n.hpp>
+#include <vector>
+
+namespace
+{
+    // Views into the language's packed string table when it has one, so nothing is copied; into
+    // ownedNames, copied out of i18n, otherwise
+    std::shared_ptr<const i18n::StringTable> table;
+    std::vector<std::string> ownedNames;
+    std::vector<std::string_view> names;
+    std::vector<std::string> sprites;
+
+    void loadNames(pksm::Language lang, std::vector<std::string_view>& out)
+    {
+        if ((table = i18n::table(lang)))
+        {
+            if (i18n::StringTable::List packed = table->list("species.txt"))
+            {
+                out.clear();
+                for (size_t i = 0; i < packed.size(); i++)
+                    out.push_back(packed[i]);
+                return;
+            }
+        }
+        ownedNames = i18n::rawSpecies(lang);
+        out.assign(ownedNames.begin(), ownedNames.end());
+    }
+
+    // Sprites are named after the lowercased English name, without punctuation and with gender signs
+    // spelled out
+    std::string spritePath(std::string_view view)
+    {
+        std::string name(view);
+        std::size_t found = name.find(".");
+        if (found != std::string::npos)
+            name.erase(name.begin() + found);
+        found = name.find("’");
+        if (found != std::string::npos)
+            name.erase(name.begin() + found, name.end() - 1);
+        found = name.find("♀");
+        if (found != std::string::npos)
+            name.replace(name.begin() + found, name.end(), "-f");
+        found = name.find("♂");
+        if (found != std::string::npos)
+            name.replace(name.begin() + found, name.end(), "-m");
+        found = name.find(" ");
+        if (found != std::string::npos)
+            name.replace(found, 1, "-");
+        found = name.find(":");
+        if (found != std::string::npos)
+            name.erase(name.begin() + found);
+        std::for_each(name.begin(), name.end(), [](char& c) { c = ::tolower(c); });
+        return "romfs:/" + name + ".jpg";
+    }
+}
+
+namespace SpeciesNames
+{
+    void load(pksm::Language lang)
+    {
+        // The sprite files only have English names
+        std::vector<std::string_view> english;
+        loadNames(pksm::Language::ENG, english);
+        sprites.clear();
+        sprites.reserve(english.size());
+        for (std::string_view name : english)
+            sprites.push_back(spritePath(name));
+
+        loadNames(lang, names);
+    }
+
+    std::string_view name(pksm::Species species)
+    {
+        if (names.empty())
+            return "FILE NOT FOUND";
+        if (species == pksm::Species::None)
+            return "(Empty Space)";
+        if (size_t(species) < names.size())
+            return names[size_t(species)];
+        return {};
+    }
+
+    std::string_view sprite(pksm::Species species)
+    {
+        if (species == pksm::Species::None || names.empty() || size_t(species) >= sprites.size())
+            return {};
+        return sprites[size_t(species)];
+    }
+}
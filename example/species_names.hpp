@@ -0,0 +1,40 @@
+/*
+    Borealis, a Nintendo Switch UI Library
+    Copyright (C) 2019-2020  natinusala
+    Copyright (C) 2019  p-sam
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <enums/Language.hpp>
+#include <enums/Species.hpp>
+#include <string_view>
+
+// Display names and sprite paths of every species, taken once from PKSM-core's i18n (straight out of
+// the packed string table where there is one) so that naming a box or bank slot is an index instead
+// of a scan through species.txt. Loaded once before any lookups; after that it's only read, so
+// workers can use it too
+namespace SpeciesNames
+{
+    void load(pksm::Language lang);
+
+    // "(Empty Space)" for Species::None, and "FILE NOT FOUND" for anything when species.txt couldn't
+    // be read
+    std::string_view name(pksm::Species species);
+    // romfs path to the species' sprite; empty where name() has none
+    std::string_view sprite(pksm::Species species);
+}
@@ -28,6 +28,8 @@
 #define CRYPTO_HPP
 
 #include "utils/coretypes.h"
+#include "utils/endian.hpp"
+#include "utils/storage.hpp"
 #include <array>
 #include <memory>
 #include <string>
@@ -45,6 +47,16 @@ namespace pksm::crypto
         return x & 0x0000003Fu;
     }
 
+    // Implementations behind ccitt16, crc16 and crc16_noinvert. Reference is the original bit- and
+    // byte-at-a-time code, kept to check SlicingBy8 against; SlicingBy8 is the default
+    enum class CrcBackend
+    {
+        Reference,
+        SlicingBy8
+    };
+    CrcBackend crcBackend(void);
+    void crcBackend(CrcBackend backend);
+
     u16 ccitt16(const u8* buf, size_t len);
     u16 crc16(const u8* buf, size_t len);
     u16 crc16_noinvert(const u8* buf, size_t len);
@@ -52,7 +64,7 @@ namespace pksm::crypto
     u32 sum32(const u8* buf, size_t len);
 
     // This SHA256 implementation is Brad Conte's. It has been modified to have a C++-style
-    // interface.
+    // interface, and uses the ARMv8 or x86 SHA instructions when they are available.
     class SHA256
     {
     private:
@@ -82,8 +94,8 @@ namespace pksm::crypto
     {
         class SCBlock
         {
-            friend std::vector<std::shared_ptr<SCBlock>> getBlockList(
-                std::shared_ptr<u8[]> data, size_t length);
+            friend std::vector<SCBlock> getBlockList(u8* data, size_t length);
+            friend class StoredBlocks;
 
         public:
             enum class SCBlockType : u8
@@ -110,9 +122,13 @@ namespace pksm::crypto
                 Double = 17,
             };
             u32 key() const;
+            // Blocks start out encrypted; only their headers are decoded when the list is built.
             // Nop if in proper state
             void encrypt();
             void decrypt();
+            // Whether the block has been decrypted, and so possibly written to, since it was last
+            // encrypted
+            bool decrypted() const { return !currentlyEncrypted; }
 
             u8* decryptedData()
             {
@@ -120,18 +136,22 @@ namespace pksm::crypto
                 return rawData();
             }
 
+            SCBlock(SCBlock&&) = default;
+            SCBlock& operator=(SCBlock&&) = default;
+
         private:
-            SCBlock(std::shared_ptr<u8[]> data, size_t& offset);
+            SCBlock(u8* data, size_t& offset);
             SCBlock(const SCBlock&) = delete;
             SCBlock& operator=(const SCBlock&) = delete;
 
             // Returns pointer to data at the beginning of the block's data region, skipping block
             // identifying information
-            u8* rawData() const { return data.get() + myOffset + headerSize(type); }
+            u8* rawData() const { return data + myOffset + headerSize(type); }
             void key(u32 v);
-            // data.get() + myOffset points to the beginning of the block data: *(u32*)(data.get() +
-            // myOffset) == key
-            std::shared_ptr<u8[]> data = nullptr;
+            // data + myOffset points to the beginning of the block data:
+            // *(u32*)(data + myOffset) == key. The buffer is owned by whoever built the block list,
+            // and must outlive it
+            u8* data = nullptr;
             size_t myOffset;
             size_t dataLength;
             SCBlockType type;
@@ -141,13 +161,50 @@ namespace pksm::crypto
             size_t encryptedDataSize();
             static size_t arrayEntrySize(SCBlockType type);
             static size_t headerSize(SCBlockType type);
+            // Decodes the header of the block starting at block, which must already be XORed, and
+            // returns the size of the whole block. dataLength is only set for objects and arrays
+            static size_t decodeHeader(
+                const u8* block, SCBlockType& type, SCBlockType& subtype, size_t& dataLength);
+        };
+
+        // Finds blocks in a save that is still as stored, XORed and with every block encrypted,
+        // decoding only block headers to do so, and then only the bytes that are asked for. For
+        // looking at a few blocks of a save without loading it
+        class StoredBlocks
+        {
+        public:
+            // Walks every block header. Throws like getBlockList if one can't be decoded
+            explicit StoredBlocks(Storage& storage);
+
+            // Decodes count bytes of the key block's data, starting position bytes in. False if
+            // there is no such block or it's too short
+            bool read(u32 key, size_t position, u8* out, size_t count);
+
+        private:
+            struct Location
+            {
+                u32 key;
+                size_t offset;
+                size_t dataOffset;
+                size_t end;
+            };
+
+            Storage& storage;
+            // Sorted by key, as the blocks are stored
+            std::vector<Location> blocks;
         };
 
         void applyXor(std::shared_ptr<u8[]> data, size_t length);
+        // Writes the XORed form of src into dest, including the untouched trailing hash. src and
+        // dest may be the same buffer. Anything 32 bytes or shorter is all hash, so it's only
+        // copied
+        void applyXor(const u8* src, u8* dest, size_t length);
         void sign(std::shared_ptr<u8[]> data, size_t length);
+        // Equivalent to applyXor followed by sign, but only walks the save once
+        void applyXorAndSign(std::shared_ptr<u8[]> data, size_t length);
         bool verify(std::shared_ptr<u8[]> data, size_t length);
-        std::vector<std::shared_ptr<SCBlock>> getBlockList(
-            std::shared_ptr<u8[]> data, size_t length);
+        // Blocks are returned in the order they are stored in, which is sorted by key
+        std::vector<SCBlock> getBlockList(u8* data, size_t length);
     }
 
     namespace pkm
@@ -183,26 +240,49 @@ namespace pksm::crypto
             }
         }
 
+        // XORs size bytes with the seedStep keystream, two bytes per step. Several steps are
+        // computed at once using jump-ahead constants, vectorized with NEON or SSE2 where available
+        void crypt(u8* data, u32 key, size_t size);
+
         template <size_t Size>
-        constexpr void crypt(u8* data, u32 key)
+        void crypt(u8* data, u32 key)
         {
-            for (size_t i = 0; i < Size; i += 2)
+            crypt(data, key, Size);
+        }
+
+        // Raw encrypt/decrypt of a stored gen 4+ Pokemon: PID/encryption constant at 0, checksum at
+        // 6 and four shuffled blocks starting at 8. Gens 4 and 5 seed the box data with the
+        // checksum and the party data with the PID; later generations seed both with the
+        // encryption constant
+        template <size_t BlockLength, size_t BoxLength, size_t PartyLength, bool ChecksumSeed>
+        void encryptSlot(u8* data, bool party)
+        {
+            u32 ec  = LittleEndian::convertTo<u32>(data);
+            u16 chk = 0;
+            for (size_t i = 8; i < BoxLength; i += 2)
+            {
+                chk += LittleEndian::convertTo<u16>(data + i);
+            }
+            LittleEndian::convertFrom<u16>(data + 6, chk);
+            blockShuffle<BlockLength>(data + 8, InvertedBlockPositions[(ec >> 13) & 31]);
+            crypt<BoxLength - 8>(data + 8, ChecksumSeed ? chk : ec);
+            if (party)
             {
-                key = seedStep(key);
-                data[i] ^= (key >> 16);
-                data[i + 1] ^= (key >> 24);
+                crypt<PartyLength - BoxLength>(data + BoxLength, ec);
             }
         }
 
-        // NOTE: Use the templated version wherever possible. Compile-time constants are preferred
-        constexpr void crypt(u8* data, u32 key, size_t size)
+        template <size_t BlockLength, size_t BoxLength, size_t PartyLength, bool ChecksumSeed>
+        void decryptSlot(u8* data, bool party)
         {
-            for (size_t i = 0; i < size; i += 2)
+            u32 ec = LittleEndian::convertTo<u32>(data);
+            crypt<BoxLength - 8>(
+                data + 8, ChecksumSeed ? LittleEndian::convertTo<u16>(data + 6) : ec);
+            if (party)
             {
-                key = seedStep(key);
-                data[i] ^= (key >> 16);
-                data[i + 1] ^= (key >> 24);
+                crypt<PartyLength - BoxLength>(data + BoxLength, ec);
             }
+            blockShuffle<BlockLength>(data + 8, (ec >> 13) & 31);
         }
     }
 }
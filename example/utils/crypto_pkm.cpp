@@ -0,0 +1,149 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "utils/crypto.hpp"
+#include "utils/endian.hpp"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace pksm::crypto::pkm
+{
+    namespace
+    {
+        struct LcgJump
+        {
+            u32 mult;
+            u32 add;
+        };
+
+        // seedStep applied steps times, folded into a single multiply-add
+        constexpr LcgJump jump(size_t steps)
+        {
+            LcgJump ret{1, 0};
+            for (size_t i = 0; i < steps; i++)
+            {
+                ret.mult = ret.mult * 0x41C64E6D;
+                ret.add  = ret.add * 0x41C64E6D + 0x6073;
+            }
+            return ret;
+        }
+
+        // Each lane produces every LANES-th key, so one round covers 2 * LANES bytes
+        constexpr size_t LANES     = 8;
+        constexpr LcgJump laneJump = jump(LANES);
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        // Handles whole 16-byte rounds and returns how many bytes were done. lanes are left at the
+        // keys for the first byte after that
+        size_t cryptVector(u8* data, size_t size, u32* lanes)
+        {
+            const uint32x4_t mult = vdupq_n_u32(laneJump.mult);
+            const uint32x4_t add  = vdupq_n_u32(laneJump.add);
+            uint32x4_t low        = vld1q_u32(lanes);
+            uint32x4_t high       = vld1q_u32(lanes + 4);
+            size_t i              = 0;
+            for (; i + 2 * LANES <= size; i += 2 * LANES)
+            {
+                uint16x8_t stream = vcombine_u16(vshrn_n_u32(low, 16), vshrn_n_u32(high, 16));
+                vst1q_u8(data + i, veorq_u8(vld1q_u8(data + i), vreinterpretq_u8_u16(stream)));
+                low  = vmlaq_u32(add, low, mult);
+                high = vmlaq_u32(add, high, mult);
+            }
+            vst1q_u32(lanes, low);
+            vst1q_u32(lanes + 4, high);
+            return i;
+        }
+#elif defined(__SSE2__)
+        // SSE2 has no 32-bit low multiply, so do the even and odd lanes separately
+        inline __m128i mullo32(__m128i a, __m128i b)
+        {
+            __m128i even = _mm_mul_epu32(a, b);
+            __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+
+        size_t cryptVector(u8* data, size_t size, u32* lanes)
+        {
+            const __m128i mult = _mm_set1_epi32(laneJump.mult);
+            const __m128i add  = _mm_set1_epi32(laneJump.add);
+            __m128i low        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+            __m128i high       = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + 4));
+            size_t i           = 0;
+            for (; i + 2 * LANES <= size; i += 2 * LANES)
+            {
+                // Arithmetic shifts keep the top halves intact through the signed pack
+                __m128i stream =
+                    _mm_packs_epi32(_mm_srai_epi32(low, 16), _mm_srai_epi32(high, 16));
+                __m128i* block = reinterpret_cast<__m128i*>(data + i);
+                _mm_storeu_si128(block, _mm_xor_si128(_mm_loadu_si128(block), stream));
+                low  = _mm_add_epi32(mullo32(low, mult), add);
+                high = _mm_add_epi32(mullo32(high, mult), add);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + 4), high);
+            return i;
+        }
+#endif
+    }
+
+    void crypt(u8* data, u32 key, size_t size)
+    {
+        u32 lanes[LANES];
+        for (size_t lane = 0; lane < LANES; lane++)
+        {
+            key         = seedStep(key);
+            lanes[lane] = key;
+        }
+
+        size_t i = 0;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__SSE2__)
+        if constexpr (pksm::internal::ENDIAN_littleEndian)
+        {
+            i = cryptVector(data, size, lanes);
+        }
+#endif
+        // Independent lanes still break the multiply chain without SIMD
+        for (; i + 2 * LANES <= size; i += 2 * LANES)
+        {
+            for (size_t lane = 0; lane < LANES; lane++)
+            {
+                data[i + 2 * lane] ^= (lanes[lane] >> 16);
+                data[i + 2 * lane + 1] ^= (lanes[lane] >> 24);
+                lanes[lane] = lanes[lane] * laneJump.mult + laneJump.add;
+            }
+        }
+        for (size_t lane = 0; i < size; i += 2, lane++)
+        {
+            data[i] ^= (lanes[lane] >> 16);
+            data[i + 1] ^= (lanes[lane] >> 24);
+        }
+    }
+}
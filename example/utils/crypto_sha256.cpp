@@ -25,6 +25,16 @@
  */
 
 #include "utils/crypto.hpp"
+#include <algorithm>
+
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define SHA256_ARM_EXTENSIONS
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_X86_EXTENSIONS
+#endif
 
 #define SHA256_BLOCK_SIZE 32
 
@@ -54,6 +64,178 @@ namespace pksm::crypto
             0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
     }
 
+    namespace internal
+    {
+        using Sha256Transform = void (*)(u32* state, const u8* data, size_t blocks);
+
+        void sha256TransformPortable(u32* state, const u8* data, size_t blocks)
+        {
+            uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+
+            for (; blocks > 0; blocks--, data += 64)
+            {
+                for (i = 0, j = 0; i < 16; ++i, j += 4)
+                    m[i] =
+                        (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+                for (; i < 64; ++i)
+                    m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+
+                a = state[0];
+                b = state[1];
+                c = state[2];
+                d = state[3];
+                e = state[4];
+                f = state[5];
+                g = state[6];
+                h = state[7];
+
+                for (i = 0; i < 64; ++i)
+                {
+                    t1 = h + EP1(e) + CH(e, f, g) + sha256_table[i] + m[i];
+                    t2 = EP0(a) + MAJ(a, b, c);
+                    h  = g;
+                    g  = f;
+                    f  = e;
+                    e  = d + t1;
+                    d  = c;
+                    c  = b;
+                    b  = a;
+                    a  = t1 + t2;
+                }
+
+                state[0] += a;
+                state[1] += b;
+                state[2] += c;
+                state[3] += d;
+                state[4] += e;
+                state[5] += f;
+                state[6] += g;
+                state[7] += h;
+            }
+        }
+
+#if defined(SHA256_ARM_EXTENSIONS)
+        // ARMv8 SHA2 instructions. The Switch build always has these (-march=armv8-a+crypto), so
+        // this is selected at compile time
+        void sha256TransformArm(u32* state, const u8* data, size_t blocks)
+        {
+            uint32x4_t abcd = vld1q_u32(state);
+            uint32x4_t efgh = vld1q_u32(state + 4);
+
+            for (; blocks > 0; blocks--, data += 64)
+            {
+                const uint32x4_t abcdSave = abcd;
+                const uint32x4_t efghSave = efgh;
+
+                uint32x4_t msg[4];
+                for (size_t i = 0; i < 4; i++)
+                {
+                    msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+                }
+
+                // Sixteen groups of four rounds; msg[i % 4] always holds the next four words of
+                // the message schedule
+                for (size_t i = 0; i < 16; i++)
+                {
+                    const uint32x4_t wk = vaddq_u32(msg[i % 4], vld1q_u32(sha256_table + i * 4));
+                    if (i < 12)
+                    {
+                        msg[i % 4] = vsha256su1q_u32(vsha256su0q_u32(msg[i % 4], msg[(i + 1) % 4]),
+                            msg[(i + 2) % 4], msg[(i + 3) % 4]);
+                    }
+                    const uint32x4_t prevAbcd = abcd;
+                    abcd                      = vsha256hq_u32(abcd, efgh, wk);
+                    efgh                      = vsha256h2q_u32(efgh, prevAbcd, wk);
+                }
+
+                abcd = vaddq_u32(abcd, abcdSave);
+                efgh = vaddq_u32(efgh, efghSave);
+            }
+
+            vst1q_u32(state, abcd);
+            vst1q_u32(state + 4, efgh);
+        }
+#elif defined(SHA256_X86_EXTENSIONS)
+        // Intel SHA extensions. Not every x86 CPU has them, so this is selected at runtime
+        __attribute__((target("sha,sse4.1,ssse3"))) void sha256TransformX86(
+            u32* state, const u8* data, size_t blocks)
+        {
+            const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+            // The instructions want the state as ABEF/CDGH rather than ABCD/EFGH
+            __m128i tmp  = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0xB1);
+            __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(state + 4)), 0x1B);
+            __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+            cdgh         = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+            for (; blocks > 0; blocks--, data += 64)
+            {
+                const __m128i abefSave = abef;
+                const __m128i cdghSave = cdgh;
+
+                __m128i msg[4];
+                for (size_t i = 0; i < 4; i++)
+                {
+                    msg[i] = _mm_shuffle_epi8(
+                        _mm_loadu_si128((const __m128i*)(data + i * 16)), byteSwap);
+                }
+
+                for (size_t i = 0; i < 16; i++)
+                {
+                    __m128i wk = _mm_add_epi32(
+                        msg[i % 4], _mm_loadu_si128((const __m128i*)(sha256_table + i * 4)));
+                    if (i < 12)
+                    {
+                        msg[i % 4] = _mm_sha256msg2_epu32(
+                            _mm_add_epi32(_mm_sha256msg1_epu32(msg[i % 4], msg[(i + 1) % 4]),
+                                _mm_alignr_epi8(msg[(i + 3) % 4], msg[(i + 2) % 4], 4)),
+                            msg[(i + 3) % 4]);
+                    }
+                    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+                    wk   = _mm_shuffle_epi32(wk, 0x0E);
+                    abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+                }
+
+                abef = _mm_add_epi32(abef, abefSave);
+                cdgh = _mm_add_epi32(cdgh, cdghSave);
+            }
+
+            tmp  = _mm_shuffle_epi32(abef, 0x1B);
+            cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+            _mm_storeu_si128((__m128i*)state, _mm_blend_epi16(tmp, cdgh, 0xF0));
+            _mm_storeu_si128((__m128i*)(state + 4), _mm_alignr_epi8(cdgh, tmp, 8));
+        }
+
+        bool x86HasShaExtensions()
+        {
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1) ||
+                !(ecx & bit_SSSE3))
+            {
+                return false;
+            }
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            {
+                return false;
+            }
+            return ebx & (1u << 29);
+        }
+#endif
+
+        Sha256Transform sha256Transform()
+        {
+#if defined(SHA256_ARM_EXTENSIONS)
+            return sha256TransformArm;
+#elif defined(SHA256_X86_EXTENSIONS)
+            static const Sha256Transform transform =
+                x86HasShaExtensions() ? sha256TransformX86 : sha256TransformPortable;
+            return transform;
+#else
+            return sha256TransformPortable;
+#endif
+        }
+    }
+
     std::array<u8, 32> sha256(const u8* buf, size_t len)
     {
         SHA256 context;
@@ -61,60 +243,38 @@ namespace pksm::crypto
         return context.finish();
     }
 
-    void SHA256::update()
-    {
-        uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-
-        for (i = 0, j = 0; i < 16; ++i, j += 4)
-            m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-        for (; i < 64; ++i)
-            m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
-
-        a = state[0];
-        b = state[1];
-        c = state[2];
-        d = state[3];
-        e = state[4];
-        f = state[5];
-        g = state[6];
-        h = state[7];
-
-        for (i = 0; i < 64; ++i)
-        {
-            t1 = h + EP1(e) + CH(e, f, g) + internal::sha256_table[i] + m[i];
-            t2 = EP0(a) + MAJ(a, b, c);
-            h  = g;
-            g  = f;
-            f  = e;
-            e  = d + t1;
-            d  = c;
-            c  = b;
-            b  = a;
-            a  = t1 + t2;
-        }
-
-        state[0] += a;
-        state[1] += b;
-        state[2] += c;
-        state[3] += d;
-        state[4] += e;
-        state[5] += f;
-        state[6] += g;
-        state[7] += h;
-    }
+    void SHA256::update() { internal::sha256Transform()(state.data(), data, 1); }
 
     void SHA256::update(const u8* buf, size_t len)
     {
-        for (size_t i = 0; i < len; i++)
+        // Top off a partially filled buffer first
+        if (dataLength > 0)
         {
-            data[dataLength++] = buf[i];
-            if (dataLength == 64)
+            size_t copy = std::min(len, size_t(64 - dataLength));
+            std::copy(buf, buf + copy, data + dataLength);
+            dataLength += copy;
+            buf += copy;
+            len -= copy;
+            if (dataLength < 64)
             {
-                update();
-                bitLength += 512;
-                dataLength = 0;
+                return;
             }
+            update();
+            bitLength += 512;
+            dataLength = 0;
+        }
+
+        // Whole blocks are hashed straight from the caller's buffer
+        if (size_t blocks = len / 64)
+        {
+            internal::sha256Transform()(state.data(), buf, blocks);
+            bitLength += 512 * u64(blocks);
+            buf += blocks * 64;
+            len -= blocks * 64;
         }
+
+        std::copy(buf, buf + len, data);
+        dataLength = len;
     }
 
     std::array<u8, 32> SHA256::finish()
@@ -26,6 +26,13 @@
 
 #include "utils/crypto.hpp"
 #include "utils/endian.hpp"
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace pksm::crypto::swsh
 {
@@ -58,6 +65,39 @@ namespace pksm::crypto::swsh
             };
         // clang-format on
 
+        // The pad repeated 16 times, so that every 16-byte lane of a chunk this size lines up with
+        // the pad and the XOR never needs a modulus
+        constexpr std::array<u8, xorpad.size() * 16> expandXorpad()
+        {
+            std::array<u8, xorpad.size() * 16> ret{};
+            for (size_t i = 0; i < ret.size(); i++)
+            {
+                ret[i] = xorpad[i % xorpad.size()];
+            }
+            return ret;
+        }
+
+        constexpr std::array<u8, xorpad.size() * 16> wideXorpad = expandXorpad();
+
+        // dest = src ^ pad for 16 bytes. The pointers may alias
+        inline void xor16(u8* dest, const u8* src, const u8* pad)
+        {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+            vst1q_u8(dest, veorq_u8(vld1q_u8(src), vld1q_u8(pad)));
+#elif defined(__SSE2__)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest),
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(pad))));
+#else
+            u64 words[2], padWords[2];
+            memcpy(words, src, 16);
+            memcpy(padWords, pad, 16);
+            words[0] ^= padWords[0];
+            words[1] ^= padWords[1];
+            memcpy(dest, words, 16);
+#endif
+        }
+
         std::array<u8, 32> computeHash(u8* data, size_t length)
         {
             SHA256 context;
@@ -67,6 +107,26 @@ namespace pksm::crypto::swsh
             return context.finish();
         }
 
+        // XORs length bytes with the pad, starting from the beginning of the pad
+        void xorPadded(const u8* src, u8* dest, size_t length)
+        {
+            size_t i = 0;
+            for (; i + wideXorpad.size() <= length; i += wideXorpad.size())
+            {
+                for (size_t j = 0; j < wideXorpad.size(); j += 16)
+                {
+                    xor16(dest + i + j, src + i + j, wideXorpad.data() + j);
+                }
+            }
+
+            // i is a multiple of the pad size here, so the leftovers start at the beginning of the
+            // pad
+            for (size_t j = 0; i + j < length; j++)
+            {
+                dest[i + j] = src[i + j] ^ wideXorpad[j];
+            }
+        }
+
         class XorShift32
         {
         private:
@@ -106,10 +166,67 @@ namespace pksm::crypto::swsh
                 return ret;
             }
 
+            // Same as calling next() count times
+            void skip(size_t count)
+            {
+                for (; mCounter != 0 && count > 0; count--)
+                {
+                    next();
+                }
+                for (; count >= 4; count -= 4)
+                {
+                    advance(mSeed);
+                }
+                for (; count > 0; count--)
+                {
+                    next();
+                }
+            }
+
             u32 next32()
             {
                 return next() | (u32(next()) << 8) | (u32(next()) << 16) | (u32(next()) << 24);
             }
+
+            // Same result as XORing every byte of buf with next(), but consumes the stream a whole
+            // state at a time instead of a byte at a time
+            void crypt(u8* buf, size_t length)
+            {
+                size_t i = 0;
+                // Finish off a partially used state first so that the rest is word-aligned
+                for (; mCounter != 0 && i < length; i++)
+                {
+                    buf[i] ^= next();
+                }
+
+                if constexpr (pksm::internal::ENDIAN_littleEndian)
+                {
+                    // The states themselves are inherently serial, but four of them can be
+                    // applied with a single vector XOR
+                    for (; i + 16 <= length; i += 16)
+                    {
+                        u32 stream[4];
+                        for (u32& word : stream)
+                        {
+                            word = mSeed;
+                            advance(mSeed);
+                        }
+                        xor16(buf + i, buf + i, reinterpret_cast<const u8*>(stream));
+                    }
+                }
+
+                for (; i + 4 <= length; i += 4)
+                {
+                    LittleEndian::convertFrom<u32>(
+                        buf + i, LittleEndian::convertTo<u32>(buf + i) ^ mSeed);
+                    advance(mSeed);
+                }
+
+                for (; i < length; i++)
+                {
+                    buf[i] ^= next();
+                }
+            }
         };
 
         class CryptoException : public std::exception
@@ -129,12 +246,55 @@ namespace pksm::crypto::swsh
 
     void applyXor(std::shared_ptr<u8[]> data, size_t length)
     {
-        for (size_t i = 0; i < length - 32; i++)
+        applyXor(data.get(), data.get(), length);
+    }
+
+    void applyXor(const u8* src, u8* dest, size_t length)
+    {
+        if (length <= 32)
         {
-            data[i] ^= internal::xorpad[i % internal::xorpad.size()];
+            if (src != dest)
+            {
+                std::copy(src, src + length, dest);
+            }
+            return;
+        }
+
+        const size_t end = length - 32;
+        internal::xorPadded(src, dest, end);
+
+        if (src != dest)
+        {
+            std::copy(src + end, src + length, dest + end);
         }
     }
 
+    void applyXorAndSign(std::shared_ptr<u8[]> data, size_t length)
+    {
+        if (length <= 32)
+        {
+            return;
+        }
+
+        // Hash each chunk right after XORing it, while it's still in cache. Chunks are a multiple
+        // of the pad size, so each one starts at the beginning of the pad
+        constexpr size_t CHUNK_SIZE = internal::wideXorpad.size() * 32;
+        const size_t end            = length - 32;
+
+        SHA256 context;
+        context.update(internal::hashBegin.data(), internal::hashBegin.size());
+        for (size_t i = 0; i < end; i += CHUNK_SIZE)
+        {
+            size_t chunk = std::min(CHUNK_SIZE, end - i);
+            internal::xorPadded(data.get() + i, data.get() + i, chunk);
+            context.update(data.get() + i, chunk);
+        }
+        context.update(internal::hashEnd.data(), internal::hashEnd.size());
+
+        auto hash = context.finish();
+        std::copy(hash.begin(), hash.end(), data.get() + end);
+    }
+
     void sign(std::shared_ptr<u8[]> data, size_t length)
     {
         if (length > 32)
@@ -161,26 +321,91 @@ namespace pksm::crypto::swsh
         return true;
     }
 
-    std::vector<std::shared_ptr<SCBlock>> getBlockList(std::shared_ptr<u8[]> data, size_t length)
+    std::vector<SCBlock> getBlockList(u8* data, size_t length)
     {
-        std::vector<std::shared_ptr<SCBlock>> ret;
+        std::vector<SCBlock> ret;
         size_t offset = 0;
         while (offset < length - 32)
         {
-            ret.emplace_back(new SCBlock(data, offset));
+            ret.push_back(SCBlock(data, offset));
         }
 
         return ret;
     }
 
-    SCBlock::SCBlock(std::shared_ptr<u8[]> data, size_t& offset) : data(data), myOffset(offset)
+    StoredBlocks::StoredBlocks(Storage& storage) : storage(storage)
     {
-        // Key size
-        offset += 4;
+        const size_t end = storage.size() > 32 ? storage.size() - 32 : 0;
+        size_t offset    = 0;
+        while (offset < end)
+        {
+            // Long enough for any header. Past the end of the file it's left zeroed
+            u8 header[10] = {};
+            Span<const u8> stored = storage.read(offset, sizeof(header));
+            for (size_t i = 0; i < stored.size(); i++)
+            {
+                header[i] = stored[i] ^ internal::xorpad[(offset + i) % internal::xorpad.size()];
+            }
 
-        internal::XorShift32 xorShift(key());
+            SCBlock::SCBlockType type, subtype;
+            size_t dataLength;
+            size_t size = SCBlock::decodeHeader(header, type, subtype, dataLength);
+            blocks.push_back({LittleEndian::convertTo<u32>(header), offset,
+                offset + SCBlock::headerSize(type), offset + size});
+            offset += size;
+        }
+    }
+
+    bool StoredBlocks::read(u32 key, size_t position, u8* out, size_t count)
+    {
+        auto found = std::lower_bound(blocks.begin(), blocks.end(), key,
+            [](const Location& block, u32 key) { return block.key < key; });
+        if (found == blocks.end() || found->key != key ||
+            found->dataOffset + position + count > found->end)
+        {
+            return false;
+        }
 
-        type = SCBlockType(data[offset] ^= xorShift.next());
+        // The block's stream starts right after its key
+        const size_t start = found->dataOffset + position;
+        internal::XorShift32 xorShift(key);
+        xorShift.skip(start - found->offset - 4);
+
+        size_t done = 0;
+        while (done < count)
+        {
+            Span<const u8> stored = storage.read(start + done, count - done);
+            if (stored.empty())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < stored.size(); i++)
+            {
+                out[done + i] =
+                    stored[i] ^ internal::xorpad[(start + done + i) % internal::xorpad.size()];
+            }
+            xorShift.crypt(out + done, stored.size());
+            done += stored.size();
+        }
+        return true;
+    }
+
+    SCBlock::SCBlock(u8* data, size_t& offset) : data(data), myOffset(offset)
+    {
+        // Only the header is decoded here, into locals; the buffer itself is left encrypted until
+        // something actually asks for the block's data through decryptedData()
+        currentlyEncrypted = true;
+
+        offset += decodeHeader(data + offset, type, subtype, dataLength);
+    }
+
+    size_t SCBlock::decodeHeader(
+        const u8* block, SCBlockType& type, SCBlockType& subtype, size_t& dataLength)
+    {
+        const u32 key = LittleEndian::convertTo<u32>(block);
+        internal::XorShift32 xorShift(key);
+
+        type = SCBlockType(block[4] ^ xorShift.next());
 
         switch (type)
         {
@@ -188,36 +413,17 @@ namespace pksm::crypto::swsh
             case SCBlockType::Bool2:
             case SCBlockType::Bool3:
                 // No extra data
-                offset++;
-                break;
+                return 5;
             case SCBlockType::Object:
-            {
-                dataLength =
-                    LittleEndian::convertTo<u32>(data.get() + offset + 1) ^ xorShift.next32();
-                LittleEndian::convertFrom<u32>(data.get() + offset + 1, dataLength);
-                for (size_t i = 0; i < dataLength; i++)
-                {
-                    data[offset + 5 + i] ^= xorShift.next();
-                }
-                offset += 5 + dataLength;
-            }
-            break;
+                dataLength = LittleEndian::convertTo<u32>(block + 5) ^ xorShift.next32();
+                return 9 + dataLength;
             case SCBlockType::Array:
             {
-                dataLength =
-                    LittleEndian::convertTo<u32>(data.get() + offset + 1) ^ xorShift.next32();
-                LittleEndian::convertFrom<u32>(data.get() + offset + 1, dataLength);
-                subtype = SCBlockType(data[offset + 5] ^= xorShift.next());
+                dataLength = LittleEndian::convertTo<u32>(block + 5) ^ xorShift.next32();
+                subtype    = SCBlockType(block[9] ^ xorShift.next());
                 switch (subtype)
                 {
                     case SCBlockType::Bool3:
-                        // An array of booleans
-                        for (size_t i = 0; i < dataLength; i++)
-                        {
-                            data[offset + 6 + i] ^= xorShift.next();
-                        }
-                        offset += 6 + dataLength;
-                        break;
                     case SCBlockType::U8:
                     case SCBlockType::U16:
                     case SCBlockType::U32:
@@ -228,22 +434,14 @@ namespace pksm::crypto::swsh
                     case SCBlockType::S64:
                     case SCBlockType::Float:
                     case SCBlockType::Double:
-                    {
-                        size_t entrySize = arrayEntrySize(subtype);
-                        for (size_t i = 0; i < dataLength * entrySize; i++)
-                        {
-                            data[offset + 6 + i] ^= xorShift.next();
-                        }
-                        offset += 6 + (dataLength * entrySize);
-                    }
-                    break;
+                        // An array of booleans is one byte per entry, just like U8
+                        return 10 + (dataLength * arrayEntrySize(subtype));
                     default:
-                        throw internal::CryptoException(
-                            "Decoding block: Key: " + std::to_string(key()) +
-                            "\nSubtype: " + std::to_string(u8(type)));
+                        throw internal::CryptoException("Decoding block: Key: " +
+                                                        std::to_string(key) +
+                                                        "\nSubtype: " + std::to_string(u8(type)));
                 }
             }
-            break;
             case SCBlockType::U8:
             case SCBlockType::U16:
             case SCBlockType::U32:
@@ -254,17 +452,9 @@ namespace pksm::crypto::swsh
             case SCBlockType::S64:
             case SCBlockType::Float:
             case SCBlockType::Double:
-            {
-                size_t entrySize = arrayEntrySize(type);
-                for (size_t i = 0; i < entrySize; i++)
-                {
-                    data[offset + 1 + i] ^= xorShift.next();
-                }
-                offset += 1 + entrySize;
-            }
-            break;
+                return 5 + arrayEntrySize(type);
             default:
-                throw internal::CryptoException("Decoding block: Key: " + std::to_string(key()) +
+                throw internal::CryptoException("Decoding block: Key: " + std::to_string(key) +
                                                 "\nType: " + std::to_string(u8(type)));
         }
     }
@@ -274,10 +464,7 @@ namespace pksm::crypto::swsh
         if (!currentlyEncrypted)
         {
             internal::XorShift32 xorShift(key());
-            for (size_t i = 0; i < encryptedDataSize() - 4; i++)
-            {
-                data[myOffset + 4 + i] ^= xorShift.next();
-            }
+            xorShift.crypt(data + myOffset + 4, encryptedDataSize() - 4);
 
             currentlyEncrypted = true;
         }
@@ -288,10 +475,7 @@ namespace pksm::crypto::swsh
         if (currentlyEncrypted)
         {
             internal::XorShift32 xorShift(key());
-            for (size_t i = 0; i < encryptedDataSize() - 4; i++)
-            {
-                data[myOffset + 4 + i] ^= xorShift.next();
-            }
+            xorShift.crypt(data + myOffset + 4, encryptedDataSize() - 4);
 
             currentlyEncrypted = false;
         }
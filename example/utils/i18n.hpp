@@ -38,14 +38,24 @@
 #include "enums/Species.hpp"
 #include "enums/Type.hpp"
 #include "utils/coretypes.h"
+#include "utils/span.hpp"
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace i18n
 {
+    // Values' strings, sorted by value, as the raw location and geo functions return them
+    template <typename T>
+    using SortedStrings = pksm::Span<const std::pair<T, std::string>>;
+
     using initCallback = void (*)(pksm::Language);
     using exitCallback = void (*)(pksm::Language);
+    // Init callbacks run on init, or the first time any getter below is called for a language.
+    // Removing one of the default ones keeps its strings from loading until the next exit
     void addInitCallback(initCallback callback);
     void removeInitCallback(initCallback callback);
     void addExitCallback(exitCallback callback);
@@ -63,8 +73,17 @@ namespace i18n
     }
 
     // Calls the callbacks that have been registered with addInitCallback in a thread-safe manner
-    // NOTE: default callbacks include all init functions in this file
+    // NOTE: default callbacks include all init functions in this file. Calling it is optional for
+    // those: each getter below loads its own category of strings the first time it's called
     void init(pksm::Language lang);
+#ifndef _PKSMCORE_DISABLE_THREAD_SAFETY
+    // Starts loading every default category of strings for lang, each on its own thread, and
+    // returns right away. The future is ready once they all are; a getter called before that only
+    // waits for its own category, and getters for other languages don't wait at all. Other
+    // callbacks registered with addInitCallback aren't run until a getter or init is called. exit
+    // waits for these threads
+    std::shared_future<void> preload(pksm::Language lang);
+#endif
     // Calls the callbacks that have been registered with addExitCallback in a thread-safe manner
     // for all languages that have been initialized NOTE: default callbacks include all exit
     // functions in this file
@@ -73,6 +92,14 @@ namespace i18n
     const std::string& langString(pksm::Language l);
     pksm::Language langFromString(const std::string_view& value);
 
+    class StringTable;
+    // The language's packed string table (see i18n/i18n_table.hpp), read the first time it's asked
+    // for and cached until every default category of the language has loaded, or exit. nullptr if
+    // the language doesn't have one, in which case the init functions below read the text files
+    // instead
+    std::shared_ptr<const StringTable> table(pksm::Language lang);
+    void exitTable(pksm::Language lang);
+
     void initAbility(pksm::Language lang);
     void exitAbility(pksm::Language lang);
     const std::string& ability(pksm::Language lang, pksm::Ability value);
@@ -89,7 +116,9 @@ namespace i18n
         pksm::Language lang, pksm::GameVersion version, pksm::Species species, u8 form);
     std::vector<std::string> forms(
         pksm::Language lang, pksm::GameVersion version, pksm::Species species);
-    // No good raw interface for this
+    // Indices into rawForms of species' forms in version, in form order, from a static table
+    pksm::Span<const u8> formIndices(pksm::GameVersion version, pksm::Species species);
+    const std::vector<std::string>& rawForms(pksm::Language lang);
 
     void initGame(pksm::Language lang);
     void exitGame(pksm::Language lang);
@@ -137,14 +166,14 @@ namespace i18n
     void initLocation(pksm::Language lang);
     void exitLocation(pksm::Language lang);
     const std::string& location(pksm::Language lang, pksm::Generation generation, u16 value);
-    const std::map<u16, std::string>& rawLocations(pksm::Language lang, pksm::Generation g);
+    SortedStrings<u16> rawLocations(pksm::Language lang, pksm::Generation g);
 
     void initGeo(pksm::Language lang);
     void exitGeo(pksm::Language lang);
     const std::string& subregion(pksm::Language lang, u8 country, u8 value);
-    const std::map<u8, std::string>& rawSubregions(pksm::Language lang, u8 country);
+    SortedStrings<u8> rawSubregions(pksm::Language lang, u8 country);
     const std::string& country(pksm::Language lang, u8 value);
-    const std::map<u8, std::string>& rawCountries(pksm::Language lang);
+    SortedStrings<u8> rawCountries(pksm::Language lang);
 };
 
 #endif
@@ -0,0 +1,56 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include "utils/coretypes.h"
+#include <cstddef>
+
+namespace pksm
+{
+    // A view of size contiguous Ts that someone else owns
+    template <typename T>
+    class Span
+    {
+    public:
+        constexpr Span() = default;
+        constexpr Span(T* data, size_t size) : ptr(data), length(size) {}
+
+        constexpr T* data() const { return ptr; }
+        constexpr size_t size() const { return length; }
+        constexpr bool empty() const { return length == 0; }
+        constexpr T* begin() const { return ptr; }
+        constexpr T* end() const { return ptr + length; }
+        constexpr T& operator[](size_t i) const { return ptr[i]; }
+
+    private:
+        T* ptr        = nullptr;
+        size_t length = 0;
+    };
+}
+
+#endif
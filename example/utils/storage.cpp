@@ -0,0 +1,175 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#include "utils/storage.hpp"
+#include <algorithm>
+#include <stdio.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Reads start on a chunk boundary and pull in at least a window's worth
+    constexpr size_t CHUNK_SIZE  = 0x10000;
+    constexpr size_t WINDOW_SIZE = 0x100000;
+
+    class ChunkedStorage : public pksm::Storage
+    {
+    public:
+        ChunkedStorage(FILE* file, size_t size) : file(file), length(size)
+        {
+            // Every read is already large, so stdio's buffer would only add a copy
+            setvbuf(file, nullptr, _IONBF, 0);
+        }
+        ~ChunkedStorage() override { fclose(file); }
+
+        size_t size() const override { return length; }
+
+        pksm::Span<const u8> read(size_t offset, size_t count) override
+        {
+            offset = std::min(offset, length);
+            count  = std::min(count, length - offset);
+            if (offset < windowOffset || offset + count > windowOffset + windowLength)
+            {
+                size_t start = offset / CHUNK_SIZE * CHUNK_SIZE;
+                size_t end   = (offset + count + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE;
+                end          = std::min(std::max(end, start + WINDOW_SIZE), length);
+                if (end - start > windowCapacity)
+                {
+                    windowCapacity = end - start;
+                    window         = std::unique_ptr<u8[]>(new u8[windowCapacity]);
+                }
+                windowOffset = start;
+                windowLength = fill(window.get(), start, end - start);
+                // A short fill (the file shrank, or a read failed) may stop before offset
+                if (windowOffset + windowLength <= offset)
+                {
+                    windowLength = 0;
+                    return {};
+                }
+                count = std::min(count, windowOffset + windowLength - offset);
+            }
+            return {window.get() + (offset - windowOffset), count};
+        }
+
+        std::shared_ptr<u8[]> map() override
+        {
+            std::shared_ptr<u8[]> data = std::shared_ptr<u8[]>(new u8[length]);
+            size_t got                 = fill(data.get(), 0, length);
+            std::fill(data.get() + got, data.get() + length, 0);
+            return data;
+        }
+
+    private:
+        FILE* file;
+        size_t length;
+        std::unique_ptr<u8[]> window;
+        size_t windowOffset   = 0;
+        size_t windowLength   = 0;
+        size_t windowCapacity = 0;
+
+        size_t fill(u8* out, size_t offset, size_t count)
+        {
+            if (fseek(file, offset, SEEK_SET) != 0)
+                return 0;
+            size_t done = 0;
+            while (done < count)
+            {
+                size_t got = fread(out + done, 1, std::min(WINDOW_SIZE, count - done), file);
+                if (got == 0)
+                    break;
+                done += got;
+            }
+            return done;
+        }
+    };
+
+#ifdef __linux__
+    class MappedStorage : public pksm::Storage
+    {
+    public:
+        MappedStorage(std::shared_ptr<u8[]> memory, size_t size) : memory(memory), length(size) {}
+
+        size_t size() const override { return length; }
+
+        pksm::Span<const u8> read(size_t offset, size_t count) override
+        {
+            offset = std::min(offset, length);
+            return {memory.get() + offset, std::min(count, length - offset)};
+        }
+
+        std::shared_ptr<u8[]> map() override { return memory; }
+
+    private:
+        std::shared_ptr<u8[]> memory;
+        size_t length;
+    };
+
+    std::unique_ptr<pksm::Storage> openMapped(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+        struct stat st;
+        void* memory = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            // Private, so Sav can decrypt and edit in place without it reaching the file
+            memory = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED)
+            return nullptr;
+
+        size_t size = st.st_size;
+        return std::make_unique<MappedStorage>(
+            std::shared_ptr<u8[]>(static_cast<u8*>(memory), [size](u8* p) { munmap(p, size); }),
+            size);
+    }
+#endif
+}
+
+namespace pksm
+{
+    std::unique_ptr<Storage> Storage::open(const std::string& path)
+    {
+#ifdef __linux__
+        if (std::unique_ptr<Storage> mapped = openMapped(path))
+            return mapped;
+#endif
+        // Empty files, and anything that can't be mapped, are read instead
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file)
+            return nullptr;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        return std::make_unique<ChunkedStorage>(file, size < 0 ? 0 : size);
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include "utils/coretypes.h"
+#include "utils/span.hpp"
+#include <memory>
+#include <string>
+
+namespace pksm
+{
+    // Read access to a whole file. Linux hosts map it; everywhere else, the Switch included, it's
+    // read through a read-ahead window in large aligned chunks
+    class Storage
+    {
+    public:
+        // nullptr if the file can't be opened
+        static std::unique_ptr<Storage> open(const std::string& path);
+
+        virtual ~Storage() = default;
+
+        virtual size_t size() const = 0;
+        // Up to length bytes starting at offset; shorter at the end of the file or if reading it
+        // fails. Only good until the next read unless the file is mapped
+        virtual Span<const u8> read(size_t offset, size_t length) = 0;
+        // The whole file in memory that can be edited without touching the file, for Sav::getSave.
+        // Where the file is mapped, this is that mapping, so edits show up in read as well
+        virtual std::shared_ptr<u8[]> map() = 0;
+    };
+}
+
+#endif
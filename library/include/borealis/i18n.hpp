@@ -20,16 +20,60 @@
 
 #include <fmt/core.h>
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace brls::i18n
 {
 
 // TODO: add support for string arrays
 
+namespace internal
+{
+    /**
+     * 64-bit FNV-1a, usable in constant expressions
+     * so that string names can be hashed at compile time
+     */
+    constexpr uint64_t hash(std::string_view str)
+    {
+        uint64_t hash = 0xcbf29ce484222325;
+        for (char c : str)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+} // namespace internal
+
+/**
+ * A string name along with its hash, which is what
+ * translations are looked up with. Made from a literal
+ * with _i18n_key, the hash is computed at compile time
+ */
+struct StringKey
+{
+    constexpr explicit StringKey(std::string_view name)
+        : name(name)
+        , hash(internal::hash(name))
+    {
+    }
+
+    std::string_view name;
+    uint64_t hash;
+
+    /**
+     * Returns the translation, without injecting
+     * any parameters, like _i18n does
+     */
+    operator std::string() const;
+};
+
 namespace internal
 {
     std::string getRawStr(std::string stringName);
+    std::string getRawStr(StringKey key);
 } // namespace internal
 
 /**
@@ -37,9 +81,9 @@ namespace internal
  * after injecting format parameters (if any)
  */
 template <typename... Args>
-std::string getStr(std::string stringName, Args&&... args)
+std::string getStr(StringKey key, Args&&... args)
 {
-    std::string rawStr = brls::i18n::internal::getRawStr(stringName);
+    std::string rawStr = brls::i18n::internal::getRawStr(key);
 
     try
     {
@@ -47,11 +91,17 @@ std::string getStr(std::string stringName, Args&&... args)
     }
     catch (const std::exception& e)
     {
-        Logger::error("Invalid format \"{}\" from string \"{}\": {}", rawStr, stringName, e.what());
-        return stringName;
+        Logger::error("Invalid format \"{}\" from string \"{}\": {}", rawStr, key.name, e.what());
+        return std::string(key.name);
     }
 }
 
+template <typename... Args>
+std::string getStr(std::string stringName, Args&&... args)
+{
+    return getStr(StringKey(stringName), std::forward<Args>(args)...);
+}
+
 /**
  * Loads all translations of the current system locale + default locale
  * Must be called before trying to get a translation!
@@ -72,6 +122,16 @@ inline namespace literals
      * Shortcut to i18n::getStr(stringName)
      */
     std::string operator"" _i18n(const char* str, size_t len);
+
+    /**
+     * Returns the key for the given string, hashed at
+     * compile time, for call sites that look it up often
+     * Converts to its translation where a string is expected
+     */
+    constexpr StringKey operator"" _i18n_key(const char* str, size_t len)
+    {
+        return StringKey(std::string_view(str, len));
+    }
 } // namespace literals
 
 } // namespace brls::i18n
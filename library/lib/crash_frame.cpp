@@ -37,7 +37,7 @@ CrashFrame::CrashFrame(std::string text)
     this->label->setParent(this);
 
     // Button
-    this->button = (new Button(ButtonStyle::CRASH))->setLabel("brls/crash_frame/button"_i18n);
+    this->button = (new Button(ButtonStyle::CRASH))->setLabel("brls/crash_frame/button"_i18n_key);
     this->button->setParent(this);
     this->button->alpha = 0.0f;
     this->button->getClickEvent()->subscribe([](View* view) { Application::quit(); });
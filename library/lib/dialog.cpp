@@ -34,7 +34,7 @@ Dialog::Dialog(View* contentView)
     if (contentView)
         contentView->setParent(this);
 
-    this->registerAction("brls/hints/back"_i18n, Key::B, [this] { return this->onCancel(); });
+    this->registerAction("brls/hints/back"_i18n_key, Key::B, [this] { return this->onCancel(); });
 }
 
 Dialog::Dialog(std::string text)
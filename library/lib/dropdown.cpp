@@ -72,7 +72,7 @@ Dropdown::Dropdown(std::string title, std::vector<std::string> values, ValueSele
     this->hint = new Hint();
     this->hint->setParent(this);
 
-    this->registerAction("brls/hints/back"_i18n, Key::B, [this] { return this->onCancel(); });
+    this->registerAction("brls/hints/back"_i18n_key, Key::B, [this] { return this->onCancel(); });
 }
 
 void Dropdown::show(std::function<void(void)> cb, bool animate, ViewAnimation animation)
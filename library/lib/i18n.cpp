@@ -21,6 +21,7 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <unordered_map>
 
 #ifdef __SWITCH__
 #include <switch.h>
@@ -31,8 +32,23 @@
 namespace brls::i18n
 {
 
-static nlohmann::json defaultLocale = {};
-static nlohmann::json currentLocale = {};
+struct Translation
+{
+    std::string name;
+    std::string value;
+};
+
+struct KeyHash
+{
+    size_t operator()(uint64_t hash) const
+    {
+        return hash;
+    }
+};
+
+// Every string of the current and default locales, flattened to its
+// full name ("brls/hints/ok") and keyed by the hash of that name
+static std::unordered_map<uint64_t, Translation, KeyHash> strings;
 
 static bool endsWith(const std::string& str, const std::string& suffix)
 {
@@ -108,51 +124,68 @@ std::string getCurrentLocale()
     return DEFAULT_LOCALE;
 }
 
+// Adds every string under node that isn't there already, so the first
+// locale to be flattened takes precedence
+static void flatten(const nlohmann::json& node, const std::string& prefix)
+{
+    for (const auto& [key, value] : node.items())
+    {
+        std::string name = prefix + key;
+
+        if (value.is_object())
+        {
+            flatten(value, name + "/");
+            continue;
+        }
+        else if (!value.is_string())
+        {
+            continue;
+        }
+
+        auto [found, inserted] = strings.try_emplace(internal::hash(name), Translation{ name, value.get<std::string>() });
+
+        if (!inserted && found->second.name != name)
+            brls::Logger::error("Strings \"{}\" and \"{}\" have the same hash, ignoring the latter", found->second.name, name);
+    }
+}
+
 void loadTranslations()
 {
+    nlohmann::json defaultLocale = {};
+    nlohmann::json currentLocale = {};
+
     loadLocale(DEFAULT_LOCALE, &defaultLocale);
 
     std::string currentLocaleName = getCurrentLocale();
     if (currentLocaleName != DEFAULT_LOCALE)
         loadLocale(currentLocaleName, &currentLocale);
+
+    strings.clear();
+    flatten(currentLocale, "");
+    flatten(defaultLocale, "");
+}
+
+StringKey::operator std::string() const
+{
+    return brls::i18n::internal::getRawStr(*this);
 }
 
 namespace internal
 {
     std::string getRawStr(std::string stringName)
     {
-        nlohmann::json::json_pointer pointer;
-
-        try
-        {
-            pointer = nlohmann::json::json_pointer("/" + stringName);
-        }
-        catch (const std::exception& e)
-        {
-            brls::Logger::error("Error while getting string \"{}\": {}", stringName, e.what());
-            return stringName;
-        }
+        return getRawStr(StringKey(stringName));
+    }
 
-        // First look for translated string in current locale
-        try
-        {
-            return currentLocale[pointer].get<std::string>();
-        }
-        catch (...)
-        {
-        }
+    std::string getRawStr(StringKey key)
+    {
+        auto found = strings.find(key.hash);
 
-        // Then look for default locale
-        try
-        {
-            return defaultLocale[pointer].get<std::string>();
-        }
-        catch (...)
-        {
-        }
+        if (found != strings.end() && found->second.name == key.name)
+            return found->second.value;
 
         // Fallback to returning the string name
-        return stringName;
+        return std::string(key.name);
     }
 } // namespace internal
 
@@ -160,7 +193,7 @@ inline namespace literals
 {
     std::string operator"" _i18n(const char* str, size_t len)
     {
-        return brls::i18n::internal::getRawStr(std::string(str, len));
+        return brls::i18n::internal::getRawStr(StringKey(std::string_view(str, len)));
     }
 
 } // namespace literals
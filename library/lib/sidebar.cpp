@@ -100,7 +100,7 @@ SidebarItem::SidebarItem(std::string label, Sidebar* sidebar)
     Style* style = Application::getStyle();
     this->setHeight(style->Sidebar.Item.height);
 
-    this->registerAction("brls/hints/ok"_i18n, Key::A, [this] { return this->onClick(); });
+    this->registerAction("brls/hints/ok"_i18n_key, Key::A, [this] { return this->onClick(); });
 }
 
 void SidebarItem::draw(NVGcontext* vg, int x, int y, unsigned width, unsigned height, Style* style, FrameContext* ctx)
@@ -83,7 +83,7 @@ ThumbnailSidebar::ThumbnailSidebar()
     this->setBackground(ViewBackground::SIDEBAR);
     this->setWidth(style->Sidebar.width);
 
-    this->button = (new Button(ButtonStyle::PRIMARY))->setLabel("brls/thumbnail_sidebar/save"_i18n);
+    this->button = (new Button(ButtonStyle::PRIMARY))->setLabel("brls/thumbnail_sidebar/save"_i18n_key);
     this->button->setParent(this);
 }
 
@@ -0,0 +1,99 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks the slicing-by-8 CRCs against the original bit- and byte-at-a-time code, which is kept as
+// CrcBackend::Reference, on random data of random lengths and alignments
+
+#include "utils/crypto.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace pksm::crypto;
+
+namespace
+{
+    struct Checksum
+    {
+        const char* name;
+        u16 (*func)(const u8*, size_t);
+    };
+
+    u16 run(CrcBackend backend, const Checksum& checksum, const u8* buf, size_t len)
+    {
+        crcBackend(backend);
+        return checksum.func(buf, len);
+    }
+}
+
+int main(void)
+{
+    std::mt19937 rng(0xC4C16);
+    const Checksum checksums[] = {
+        {"ccitt16", ccitt16}, {"crc16", crc16}, {"crc16_noinvert", crc16_noinvert}};
+
+    size_t failures = 0;
+    size_t checks   = 0;
+
+    // CRC-16/CCITT-FALSE check value
+    const u8 digits[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    for (CrcBackend backend : {CrcBackend::Reference, CrcBackend::SlicingBy8})
+    {
+        checks++;
+        if (run(backend, checksums[0], digits, sizeof(digits)) != 0x29B1)
+        {
+            printf("ccitt16 check value wrong for backend %d\n", int(backend));
+            failures++;
+        }
+    }
+
+    std::vector<u8> buf(0x10000 + 8);
+    for (u8& byte : buf)
+    {
+        byte = rng();
+    }
+
+    for (int round = 0; round < 4000; round++)
+    {
+        // Mostly short lengths, where the head and tail loops matter, with some long ones
+        size_t len   = round % 4 == 0 ? rng() % 0x10000 : rng() % 100;
+        size_t align = rng() % 8;
+        for (const Checksum& checksum : checksums)
+        {
+            u16 reference = run(CrcBackend::Reference, checksum, buf.data() + align, len);
+            u16 sliced    = run(CrcBackend::SlicingBy8, checksum, buf.data() + align, len);
+            checks++;
+            if (reference != sliced && failures++ < 10)
+            {
+                printf("%s mismatch: length %zu, align %zu: %04X != %04X\n", checksum.name, len,
+                    align, reference, sliced);
+            }
+        }
+    }
+
+    printf("crc: %zu of %zu checks failed\n", failures, checks);
+    return failures == 0 ? 0 : 1;
+}
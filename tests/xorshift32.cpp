@@ -0,0 +1,101 @@
+/*
+ *   This file is part of PKSM-Core
+ *   Copyright (C) 2016-2020 Bernardo Giordano, Admiral Fish, piepie62
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Additional Terms 7.b and 7.c of GPLv3 apply to this file:
+ *       * Requiring preservation of specified reasonable legal notices or
+ *         author attributions in that material or in the Appropriate Legal
+ *         Notices displayed by works containing it.
+ *       * Prohibiting misrepresentation of the origin of that material,
+ *         or requiring that modified versions of such material be marked in
+ *         reasonable ways as different from the original version.
+ */
+
+// Checks XorShift32::crypt, which applies the keystream a state (or four) at a time, against
+// XORing with next() one byte at a time. The class only lives in crypto_swsh.cpp, so that's
+// included whole
+
+#include "utils/crypto_swsh.cpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using pksm::crypto::swsh::internal::XorShift32;
+
+int main(void)
+{
+    std::mt19937 rng(0x5CB10C4);
+    size_t failures = 0;
+    size_t checks   = 0;
+
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= 80; length++)
+    {
+        lengths.emplace_back(length);
+    }
+    lengths.insert(lengths.end(), {127, 128, 129, 1000, 4096, 0x1234});
+
+    for (int seedIndex = 0; seedIndex < 64; seedIndex++)
+    {
+        u32 seed = seedIndex == 0 ? 0 : seedIndex == 1 ? 0xFFFFFFFF : u32(rng());
+        // Bytes of the stream used up before crypt, so it starts partway through a state
+        for (size_t consumed = 0; consumed < 8; consumed++)
+        {
+            // Where the buffer starts relative to a 16-byte boundary
+            for (size_t align = 0; align < 16; align += 3)
+            {
+                for (size_t length : lengths)
+                {
+                    std::vector<u8> original(align + length);
+                    for (u8& byte : original)
+                    {
+                        byte = rng();
+                    }
+                    std::vector<u8> bulk   = original;
+                    std::vector<u8> scalar = original;
+
+                    XorShift32 bulkStream(seed);
+                    XorShift32 scalarStream(seed);
+                    for (size_t i = 0; i < consumed; i++)
+                    {
+                        bulkStream.next();
+                        scalarStream.next();
+                    }
+
+                    bulkStream.crypt(bulk.data() + align, length);
+                    for (size_t i = 0; i < length; i++)
+                    {
+                        scalar[align + i] ^= scalarStream.next();
+                    }
+
+                    checks++;
+                    // Both the output and where the streams are left have to match
+                    if (bulk != scalar || bulkStream.next32() != scalarStream.next32())
+                    {
+                        if (failures++ < 10)
+                        {
+                            printf("mismatch: seed %08X, %zu consumed, align %zu, length %zu\n",
+                                seed, consumed, align, length);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    printf("xorshift32: %zu of %zu checks failed\n", failures, checks);
+    return failures == 0 ? 0 : 1;
+}
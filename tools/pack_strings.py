@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+#
+# Packs one language folder of PKSM-Core strings into the table i18n reads instead of the text files.
+# The layout is described in example/i18n/i18n_table.hpp.
+#
+#   pack_strings.py resources/strings/eng resources/strings/eng.bin
+
+import os
+import struct
+import sys
+
+MAGIC = b"PKSMSTRS"
+VERSION = 1
+KIND_LIST = 0
+KIND_MAP = 1
+
+
+def is_map(name):
+    # The files i18n loads into maps, as "key|value" lines
+    return name.startswith(("countries", "locations", "subregions/"))
+
+
+def lines(path):
+    # Split the way i18n::load does: on '\n', dropping anything from a '\r', with no entry after a
+    # final newline
+    with open(path, "rb") as f:
+        data = f.read()
+    split = data.split(b"\n")
+    if split and split[-1] == b"":
+        split.pop()
+    return [line.split(b"\r")[0] for line in split]
+
+
+def parse_key(text):
+    # std::stoi with base 0: leading whitespace and sign, 0x for hex, a leading 0 for octal, and
+    # anything after the digits ignored
+    text = text.lstrip(b" \t\n\v\f\r")
+    sign = 1
+    if text[:1] in (b"+", b"-"):
+        sign = -1 if text[:1] == b"-" else 1
+        text = text[1:]
+    if text[:2].lower() == b"0x":
+        base, digits, text = 16, b"0123456789abcdefABCDEF", text[2:]
+    elif text[:1] == b"0":
+        base, digits = 8, b"01234567"
+    else:
+        base, digits = 10, b"0123456789"
+    end = 0
+    while end < len(text) and text[end] in digits:
+        end += 1
+    if end == 0 and base != 8:
+        raise ValueError("no key in line")
+    return sign * int(text[:end] or b"0", base)
+
+
+def read_map(path):
+    entries = {}
+    for line in lines(path):
+        bar = line.find(b"|")
+        # Later lines win, as with map[key] = value
+        entries[parse_key(line[: bar if bar >= 0 else len(line)]) & 0xFFFFFFFF] = line[bar + 1 :]
+    return sorted(entries.items())
+
+
+def collect(folder):
+    files = []
+    for root, _, names in os.walk(folder):
+        for name in names:
+            if name.endswith(".txt"):
+                path = os.path.join(root, name)
+                files.append((os.path.relpath(path, folder).replace(os.sep, "/"), path))
+    # Sorted by the bytes of the name, as StringTable compares them
+    return sorted(files, key=lambda f: f[0].encode())
+
+
+def pack(folder):
+    files = collect(folder)
+    header_size = 0x10 + 0x10 * len(files)
+
+    entries = []
+    indexes = bytearray()
+    strings = bytearray()
+    names = []
+    for name, path in files:
+        if is_map(name):
+            kind = KIND_MAP
+            pairs = read_map(path)
+            keys = [key for key, _ in pairs]
+            values = [value for _, value in pairs]
+        else:
+            kind = KIND_LIST
+            keys = []
+            values = lines(path)
+        entries.append((name, kind, len(values), len(indexes), keys, values))
+        indexes += bytes(4 * len(keys) + 4 * (len(values) + 1))
+        names.append(name.encode())
+
+    names_offset = header_size + len(indexes)
+    names_size = sum(len(n) for n in names)
+    strings_offset = names_offset + names_size
+
+    blob = bytearray(MAGIC + struct.pack("<II", VERSION, len(files)))
+    name_offset = names_offset
+    for (name, kind, count, index, _, _), encoded in zip(entries, names):
+        blob += struct.pack("<IHBBII", name_offset, len(encoded), kind, 0, count, header_size + index)
+        name_offset += len(encoded)
+
+    for _, kind, count, index, keys, values in entries:
+        for i, key in enumerate(keys):
+            struct.pack_into("<I", indexes, index + 4 * i, key)
+        offsets = index + 4 * len(keys)
+        for i, value in enumerate(values):
+            struct.pack_into("<I", indexes, offsets + 4 * i, strings_offset + len(strings))
+            strings += value
+        struct.pack_into("<I", indexes, offsets + 4 * count, strings_offset + len(strings))
+
+    blob += indexes
+    for encoded in names:
+        blob += encoded
+    blob += strings
+    return bytes(blob)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: pack_strings.py <language folder> <output>")
+    blob = pack(sys.argv[1])
+    with open(sys.argv[2], "wb") as f:
+        f.write(blob)
+
+
+if __name__ == "__main__":
+    main()